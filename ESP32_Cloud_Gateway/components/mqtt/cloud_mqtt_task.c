@@ -5,9 +5,9 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
-#include "driver/uart.h"
 #include "esp_system.h"
 #include "esp_log.h"
+#include "sdkconfig.h"
 #include "stdio.h"
 #include "string.h"
 #include <stdlib.h>
@@ -15,8 +15,10 @@
 #include "mqtt.h"
 #include "task_priorities.h"
 
-#define WIFI_MANAGER_TASK_PERIOD_MS     (5000)
+#define SENSOR_GEN_PERIOD_MS            (CONFIG_GATEWAY_SENSOR_GEN_PERIOD_MS)
 #define PUBLISH_WAIT_MS                 (20000)
+#define RECONNECT_MIN_MS                (1000)
+#define RECONNECT_MAX_MS                (60000)
 
 static const char *TAG   = "CLOUD_MQTT";
 static char topic[50]    = "sensor/data";
@@ -52,7 +54,8 @@ static void format_payload(char *buf, size_t buf_len, const sensor_data_t *data)
 }
 
 /**
- * @brief Generates random sensor data and pushes to queue every 5 seconds.
+ * @brief Generates random sensor data and pushes to queue every SENSOR_GEN_PERIOD_MS
+ *        (5 seconds by default, back-to-back when 0).
 */
 static void sensor_generator_task(void *pvParameters)
 {
@@ -69,19 +72,32 @@ static void sensor_generator_task(void *pvParameters)
             ESP_LOGW(TAG, "Queue full, sensor data dropped.");
         }
 
-        vTaskDelay(pdMS_TO_TICKS(WIFI_MANAGER_TASK_PERIOD_MS));     // Send every 5s
+        vTaskDelay(pdMS_TO_TICKS(SENSOR_GEN_PERIOD_MS));            // Send every period
     }
 }
 
-static void cloud_mqtt_task(void *pvParameters)
+/**
+ * @brief Connect to the broker, retrying with exponential backoff until it succeeds.
+ *
+ * Waits RECONNECT_MIN_MS after the first failure and doubles the wait after each
+ * further one, up to RECONNECT_MAX_MS.
+*/
+static void mqtt_connect_with_backoff(void)
 {
-    // Initialize and connect to AWS IoT Core
-    if (mqtt_init() != ESP_OK)
+    uint32_t backoff_ms = RECONNECT_MIN_MS;
+
+    while (mqtt_init() != ESP_OK)
     {
-        ESP_LOGE(TAG, "MQTT init failed, task exiting.");
-        vTaskDelete(NULL);      // No need for the task then
-        return;
+        ESP_LOGW(TAG, "MQTT connect failed, retrying in %lums", (unsigned long)backoff_ms);
+        vTaskDelay(pdMS_TO_TICKS(backoff_ms));
+        backoff_ms = (backoff_ms >= RECONNECT_MAX_MS / 2) ? RECONNECT_MAX_MS : backoff_ms * 2;
     }
+}
+
+static void cloud_mqtt_task(void *pvParameters)
+{
+    // Initialize and connect to AWS IoT Core
+    mqtt_connect_with_backoff();
 
     // Wait until MQTT is connected
     xEventGroupWaitBits(mqtt_event_group, MQTT_CONNECTED_BIT,
@@ -98,7 +114,14 @@ static void cloud_mqtt_task(void *pvParameters)
         {
             // Format the payload
             format_payload(payload, sizeof(payload), &data);
-            ESP_LOGI(TAG, "Publishing: %s", payload);
+            ESP_LOGD(TAG, "Publishing: %s", payload);       // Per message, keep off the publish-rate path
+
+            // The driver drops the session on a failed publish, reconnect before the next one
+            if (!mqtt_is_connected())
+            {
+                ESP_LOGW(TAG, "MQTT disconnected, reconnecting");
+                mqtt_connect_with_backoff();
+            }
 
             // Publish the payload
             if (mqtt_publish(topic, payload, qos) != ESP_OK)
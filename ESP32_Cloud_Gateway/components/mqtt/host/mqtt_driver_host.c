@@ -0,0 +1,278 @@
+/**
+ * @file mqtt_driver_host.c
+ * @brief Host (linux target) MQTT driver.
+ * 
+ * Replaces the AWS IoT driver in the host build. Speaks plain MQTT 3.1.1 over TCP
+ * (no TLS, no certificates) to a local broker or stand-in configured in menuconfig,
+ * and logs the achieved publish rate.
+*/
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#include "mqtt.h"
+
+#define MQTT_KEEPALIVE_S        (60)
+#define MQTT_ACK_TIMEOUT_S      (5)
+#define MQTT_STATS_PERIOD_MS    (5000)
+#define MQTT_PACKET_MAX         (512)
+
+#define MQTT_PKT_CONNECT        (0x10)
+#define MQTT_PKT_CONNACK        (0x20)
+#define MQTT_PKT_PUBLISH        (0x30)
+#define MQTT_PKT_PUBACK         (0x40)
+
+static const char *TAG = "MQTT_HOST";
+
+// Event group used to signal MQTT connection status
+EventGroupHandle_t mqtt_event_group;
+
+static int      sock = -1;
+static uint16_t packet_id = 0;
+static uint32_t published = 0;                  // Publishes since the last stats line
+static TickType_t stats_start = 0;
+
+// Local function prototypes
+static size_t put_remaining_length(uint8_t *buf, size_t len);
+static size_t put_string(uint8_t *buf, const char *str, size_t len);
+static esp_err_t send_all(const uint8_t *buf, size_t len);
+static esp_err_t recv_all(uint8_t *buf, size_t len);
+static void log_publish_rate(void);
+static void close_socket(void);
+static void drop_connection(void);
+
+/**
+ * @brief Connect to the local broker and complete the MQTT CONNECT/CONNACK exchange.
+ *
+ * Also used to reconnect: any socket left from the previous session is closed first.
+ *
+ * @return ESP_OK on success, ESP_FAIL if the broker is unreachable or refuses the session.
+*/
+esp_err_t mqtt_init(void)
+{
+    uint8_t packet[MQTT_PACKET_MAX];
+    uint8_t connack[4];
+    uint8_t body[MQTT_PACKET_MAX];
+    size_t  body_len = 0;
+    size_t  len = 0;
+    struct addrinfo hints = { .ai_family = AF_INET, .ai_socktype = SOCK_STREAM };
+    struct addrinfo *res = NULL;
+    struct timeval tv = { .tv_sec = MQTT_ACK_TIMEOUT_S };
+    char port[8];
+
+    // Create the EventGroup once, reconnects reuse it
+    if (mqtt_event_group == NULL) {
+        mqtt_event_group = xEventGroupCreate();
+    }
+    drop_connection();              // Reconnect: release the previous session's socket
+
+    snprintf(port, sizeof(port), "%d", CONFIG_GATEWAY_HOST_MQTT_BROKER_PORT);
+    if (getaddrinfo(CONFIG_GATEWAY_HOST_MQTT_BROKER_HOST, port, &hints, &res) != 0 || res == NULL) {
+        ESP_LOGE(TAG, "Cannot resolve %s", CONFIG_GATEWAY_HOST_MQTT_BROKER_HOST);
+        return ESP_FAIL;
+    }
+
+    sock = socket(res->ai_family, res->ai_socktype, 0);
+    if (sock < 0 || connect(sock, res->ai_addr, res->ai_addrlen) != 0) {
+        ESP_LOGE(TAG, "Cannot connect to %s:%s: %s", CONFIG_GATEWAY_HOST_MQTT_BROKER_HOST, port, strerror(errno));
+        freeaddrinfo(res);
+        close_socket();
+        return ESP_FAIL;
+    }
+    freeaddrinfo(res);
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    // CONNECT variable header: protocol "MQTT", level 4, clean session, keep-alive
+    body_len += put_string(&body[body_len], "MQTT", 4);
+    body[body_len++] = 4;
+    body[body_len++] = 0x02;
+    body[body_len++] = (uint8_t)(MQTT_KEEPALIVE_S >> 8);
+    body[body_len++] = (uint8_t)(MQTT_KEEPALIVE_S & 0xFF);
+    body_len += put_string(&body[body_len], clientID, strlen(clientID));
+
+    packet[len++] = MQTT_PKT_CONNECT;
+    len += put_remaining_length(&packet[len], body_len);
+    memcpy(&packet[len], body, body_len);
+    len += body_len;
+
+    if (send_all(packet, len) != ESP_OK || recv_all(connack, sizeof(connack)) != ESP_OK ||
+        connack[0] != MQTT_PKT_CONNACK || connack[3] != 0) {
+        ESP_LOGE(TAG, "MQTT connect refused");
+        close_socket();
+        return ESP_FAIL;
+    }
+
+    stats_start = xTaskGetTickCount();
+    xEventGroupSetBits(mqtt_event_group, MQTT_CONNECTED_BIT);
+    ESP_LOGI(TAG, "Connected to local broker %s:%s", CONFIG_GATEWAY_HOST_MQTT_BROKER_HOST, port);
+    return ESP_OK;
+}
+
+/**
+ * @brief Publish a message to the local broker.
+ *
+ * @param topic   MQTT topic string to publish to (e.g. "sensor/data").
+ * @param payload JSON string payload to publish.
+ * @param qos     Quality of Service level (0 = at most once, 1 = at least once, waits for PUBACK).
+ *
+ * @return ESP_OK on success, ESP_FAIL if not connected or publish fails.
+*/
+esp_err_t mqtt_publish(const char *topic, const char *payload, int qos)
+{
+    uint8_t packet[MQTT_PACKET_MAX];
+    uint8_t puback[4];
+    size_t  topic_len   = strlen(topic);
+    size_t  payload_len = strlen(payload);
+    size_t  body_len    = 2 + topic_len + ((qos > 0) ? 2 : 0) + payload_len;
+    size_t  len = 0;
+
+    if (!mqtt_is_connected()) {
+        ESP_LOGW(TAG, "Publish skipped — not connected");
+        return ESP_FAIL;
+    }
+    if (body_len + 5 > sizeof(packet)) {
+        ESP_LOGE(TAG, "Publish too large: %u bytes", (unsigned)body_len);
+        return ESP_FAIL;
+    }
+
+    packet[len++] = (uint8_t)(MQTT_PKT_PUBLISH | ((qos > 0) ? 0x02 : 0x00));
+    len += put_remaining_length(&packet[len], body_len);
+    len += put_string(&packet[len], topic, topic_len);
+    if (qos > 0) {
+        packet_id = (uint16_t)((packet_id == 0xFFFF) ? 1 : packet_id + 1);
+        packet[len++] = (uint8_t)(packet_id >> 8);
+        packet[len++] = (uint8_t)(packet_id & 0xFF);
+    }
+    memcpy(&packet[len], payload, payload_len);
+    len += payload_len;
+
+    if (send_all(packet, len) != ESP_OK) {
+        drop_connection();
+        ESP_LOGE(TAG, "Publish error: %s", strerror(errno));
+        return ESP_FAIL;
+    }
+
+    if (qos > 0) {
+        if (recv_all(puback, sizeof(puback)) != ESP_OK || puback[0] != MQTT_PKT_PUBACK ||
+            puback[2] != (uint8_t)(packet_id >> 8) || puback[3] != (uint8_t)(packet_id & 0xFF)) {
+            drop_connection();
+            ESP_LOGE(TAG, "No PUBACK for packet %u", packet_id);
+            return ESP_FAIL;
+        }
+    }
+
+    published++;
+    log_publish_rate();
+    return ESP_OK;
+}
+
+/**
+ * @brief Check if MQTT is currently connected
+ * @return true if connected, false otherwise
+*/
+bool mqtt_is_connected(void)
+{
+    EventBits_t bits = xEventGroupGetBits(mqtt_event_group);
+    return (bits & MQTT_CONNECTED_BIT) != 0;
+}
+
+/** @brief Encode the MQTT variable-length "remaining length" field */
+static size_t put_remaining_length(uint8_t *buf, size_t len)
+{
+    size_t n = 0;
+
+    do {
+        uint8_t byte = (uint8_t)(len % 128);
+        len /= 128;
+        buf[n++] = (len > 0) ? (uint8_t)(byte | 0x80) : byte;
+    } while (len > 0);
+    return n;
+}
+
+/** @brief Encode a length-prefixed MQTT string */
+static size_t put_string(uint8_t *buf, const char *str, size_t len)
+{
+    buf[0] = (uint8_t)(len >> 8);
+    buf[1] = (uint8_t)(len & 0xFF);
+    memcpy(&buf[2], str, len);
+    return len + 2;
+}
+
+static esp_err_t send_all(const uint8_t *buf, size_t len)
+{
+    ssize_t ret;
+
+    while (len > 0) {
+        ret = send(sock, buf, len, MSG_NOSIGNAL);
+        if (ret < 0 && errno == EINTR) continue;
+        if (ret <= 0) return ESP_FAIL;
+        buf += ret;
+        len -= (size_t)ret;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t recv_all(uint8_t *buf, size_t len)
+{
+    ssize_t ret;
+
+    while (len > 0) {
+        ret = recv(sock, buf, len, 0);
+        if (ret < 0 && errno == EINTR) continue;
+        if (ret <= 0) return ESP_FAIL;
+        buf += ret;
+        len -= (size_t)ret;
+    }
+    return ESP_OK;
+}
+
+/** @brief Log publishes per second every MQTT_STATS_PERIOD_MS */
+static void log_publish_rate(void)
+{
+    TickType_t now     = xTaskGetTickCount();
+    uint32_t   elapsed = (uint32_t)((now - stats_start) * portTICK_PERIOD_MS);
+
+    if (elapsed < MQTT_STATS_PERIOD_MS) {
+        return;
+    }
+
+    ESP_LOGI(TAG, "Published %lu messages in %lu ms (%lu msg/s)",
+             (unsigned long)published, (unsigned long)elapsed,
+             (unsigned long)((uint64_t)published * 1000U / elapsed));
+    published   = 0;
+    stats_start = now;
+}
+
+/** @brief Close the broker socket, if open */
+static void close_socket(void)
+{
+    if (sock >= 0) {
+        close(sock);
+        sock = -1;
+    }
+}
+
+/**
+ * @brief Mark the session down and close its socket.
+ *
+ * A failed send or a missing PUBACK leaves the stream in an unknown state, so the
+ * session is dropped and cloud_mqtt_task reconnects through mqtt_init().
+*/
+static void drop_connection(void)
+{
+    xEventGroupClearBits(mqtt_event_group, MQTT_CONNECTED_BIT);
+    close_socket();
+}
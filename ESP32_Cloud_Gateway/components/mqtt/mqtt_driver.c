@@ -72,8 +72,10 @@ static void mqtt_event_handler(void *event_handler_args,
  */
 esp_err_t mqtt_init(void) 
 {
-    // Create the EventGroup
-    mqtt_event_group = xEventGroupCreate();
+    // Create the EventGroup once, reconnects reuse it
+    if (mqtt_event_group == NULL) {
+        mqtt_event_group = xEventGroupCreate();
+    }
     
     // Configure MQTT client
     AWS_IoT_Client_Init_Params params = iotClientInitParamsDefault;
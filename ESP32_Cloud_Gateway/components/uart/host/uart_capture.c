@@ -0,0 +1,106 @@
+/**
+ * @file uart_capture.c
+ * @brief Reader and writer for the .ucap UART capture format.
+*/
+
+#include <string.h>
+
+#include "uart_capture.h"
+
+static void put_le16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32(uint8_t *p, uint32_t v)
+{
+    put_le16(p, (uint16_t)v);
+    put_le16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint16_t get_le16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_le32(const uint8_t *p)
+{
+    return (uint32_t)get_le16(p) | ((uint32_t)get_le16(p + 2) << 16);
+}
+
+/**
+ * @brief Create a capture file and write its header.
+ * @return File handle, or NULL on error.
+*/
+FILE *uart_capture_create(const char *path, uint32_t baud_rate)
+{
+    uint8_t header[12];
+    FILE *file = fopen(path, "wb");
+
+    if (file == NULL) return NULL;
+
+    memcpy(header, UART_CAPTURE_MAGIC, 4);
+    put_le16(&header[4], UART_CAPTURE_VERSION);
+    put_le16(&header[6], 0);
+    put_le32(&header[8], baud_rate);
+    if (fwrite(header, sizeof(header), 1, file) != 1) {
+        fclose(file);
+        return NULL;
+    }
+    return file;
+}
+
+/**
+ * @brief Append one received chunk.
+ * @return 0 on success, -1 on write error.
+*/
+int uart_capture_write(FILE *file, uint32_t delta_us, const uint8_t *data, uint16_t length)
+{
+    uint8_t record[6];
+
+    put_le32(&record[0], delta_us);
+    put_le16(&record[4], length);
+    if (fwrite(record, sizeof(record), 1, file) != 1) return -1;
+    if (length > 0 && fwrite(data, length, 1, file) != 1) return -1;
+    return 0;
+}
+
+/**
+ * @brief Open a capture file and validate its header.
+ * @return File handle positioned at the first record, or NULL if missing or not a v1 capture.
+*/
+FILE *uart_capture_open(const char *path, uart_capture_header_t *header)
+{
+    uint8_t raw[12];
+    FILE *file = fopen(path, "rb");
+
+    if (file == NULL) return NULL;
+
+    if (fread(raw, sizeof(raw), 1, file) != 1 ||
+        memcmp(raw, UART_CAPTURE_MAGIC, 4) != 0 ||
+        get_le16(&raw[4]) != UART_CAPTURE_VERSION) {
+        fclose(file);
+        return NULL;
+    }
+    header->baud_rate = get_le32(&raw[8]);
+    return file;
+}
+
+/**
+ * @brief Read the next record into data.
+ * @return 1 on success, 0 at end of file, -1 on a truncated or oversized record.
+*/
+int uart_capture_read(FILE *file, uart_capture_record_t *record, uint8_t *data, size_t size)
+{
+    uint8_t raw[6];
+
+    if (fread(raw, sizeof(raw), 1, file) != 1) {
+        return feof(file) ? 0 : -1;
+    }
+    record->delta_us = get_le32(&raw[0]);
+    record->length   = get_le16(&raw[4]);
+    if (record->length > size) return -1;
+    if (record->length > 0 && fread(data, record->length, 1, file) != 1) return -1;
+    return 1;
+}
@@ -0,0 +1,38 @@
+#ifndef UART_CAPTURE_H
+#define UART_CAPTURE_H
+
+/**
+ * @file uart_capture.h
+ * @brief UART byte-stream capture file format (.ucap).
+ * 
+ * Little-endian, one header followed by one record per received chunk:
+ *   header : "UCAP" | u16 version | u16 reserved | u32 baud rate
+ *   record : u32 microseconds since previous record | u16 length | length bytes
+ * 
+ * Record boundaries are the chunks the receiver saw, so a replay can reproduce
+ * both the timing and the UART_DATA event splitting of the original traffic.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define UART_CAPTURE_MAGIC          "UCAP"
+#define UART_CAPTURE_VERSION        (1U)
+#define UART_CAPTURE_MAX_RECORD     (4096U)     // Longest record accepted by the reader
+
+typedef struct {
+    uint32_t baud_rate;
+} uart_capture_header_t;
+
+typedef struct {
+    uint32_t delta_us;
+    uint16_t length;
+} uart_capture_record_t;
+
+// Function Prototypes
+FILE *uart_capture_create(const char *path, uint32_t baud_rate);
+int   uart_capture_write(FILE *file, uint32_t delta_us, const uint8_t *data, uint16_t length);
+FILE *uart_capture_open(const char *path, uart_capture_header_t *header);
+int   uart_capture_read(FILE *file, uart_capture_record_t *record, uint8_t *data, size_t size);
+
+#endif  // UART_CAPTURE_H
@@ -0,0 +1,493 @@
+/**
+ * @file uart_driver_host.c
+ * @brief Host (linux target) UART driver backend.
+ * 
+ * Implements the driver/uart.h subset used by uart_rxtx_task on top of a file
+ * descriptor, so the gateway can run on a workstation:
+ *   - CONFIG_GATEWAY_HOST_UART_REPLAY_FILE set  : recorded .ucap stream replayed into the RX path
+ *   - CONFIG_GATEWAY_HOST_UART_BENCH_FRAMES > 0 : socketpair fed by an in-process frame generator
+ *   - CONFIG_GATEWAY_HOST_UART_DEVICE set       : existing serial device or pty (e.g. the STM32 host build)
+ *   - otherwise                                 : new pseudo-terminal, path logged at startup
+ * 
+ * A poll task stands in for the UART ISR: it moves received bytes into the RX
+ * ring buffer and posts one UART_DATA event per chunk of at most
+ * CONFIG_GATEWAY_HOST_UART_RX_CHUNK bytes, like the hardware driver. With
+ * CONFIG_GATEWAY_HOST_UART_CAPTURE_FILE set, every chunk is also recorded.
+*/
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <termios.h>
+#include <sys/socket.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/stream_buffer.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+#include "uart.h"
+#include "task_priorities.h"
+#include "uart_capture.h"
+
+#define UART_HOST_RX_CHUNK      (CONFIG_GATEWAY_HOST_UART_RX_CHUNK)     // Bytes per UART_DATA event
+#define UART_HOST_BENCH_FRAME   "Message from STM32\n"
+#define UART_HOST_BITS_PER_BYTE (10U)   // 8N1: start + 8 data + stop
+#define UART_HOST_DRAIN_TICKS   (10U)   // RX path considered idle after this long without progress
+#define UART_HOST_STALL_TICKS   (pdMS_TO_TICKS(1000))   // Bench/replay give up when the RX path stops draining
+
+#if CONFIG_GATEWAY_HOST_UART_REPLAY_TIMING_RECORDED
+#define UART_HOST_REPLAY_PACE_RECORDED  (1)
+#else
+#define UART_HOST_REPLAY_PACE_RECORDED  (0)
+#endif
+#if CONFIG_GATEWAY_HOST_UART_REPLAY_TIMING_WIRE
+#define UART_HOST_REPLAY_PACE_WIRE      (1)
+#else
+#define UART_HOST_REPLAY_PACE_WIRE      (0)
+#endif
+
+static const char *TAG = "UART_HOST";
+
+static int uart_fd = -1;                        // Driver side of the link
+static int peer_fd = -1;                        // Benchmark / replay end of the socketpair (TX replies)
+static uint32_t baud_rate = 115200;
+static QueueHandle_t event_queue;
+static StreamBufferHandle_t rx_buffer;
+static FILE *capture_file;
+
+// Local function prototypes
+static esp_err_t open_backend(void);
+static int open_device(const char *path);
+static uint64_t now_us(void);
+static uint64_t cpu_time_us(void);
+static void wait_until_us(uint64_t deadline);
+static uint32_t drain_replies(void);
+static size_t wait_rx_drained(void);
+static bool rx_push(const uint8_t *data, size_t length, TickType_t ticks_to_wait);
+static void uart_host_rx_task(void *pvParameters);
+static void uart_host_bench_task(void *pvParameters);
+static void uart_host_replay_task(void *pvParameters);
+
+static inline bool replay_enabled(void)
+{
+    return CONFIG_GATEWAY_HOST_UART_REPLAY_FILE[0] != '\0';
+}
+
+esp_err_t uart_param_config(uart_port_t uart_num, const uart_config_t *uart_config)
+{
+    (void)uart_num;
+    baud_rate = (uint32_t)uart_config->baud_rate;
+    return ESP_OK;
+}
+
+esp_err_t uart_set_pin(uart_port_t uart_num, int tx_io_num, int rx_io_num, int rts_io_num, int cts_io_num)
+{
+    (void)uart_num;
+    (void)tx_io_num;
+    (void)rx_io_num;
+    (void)rts_io_num;
+    (void)cts_io_num;
+    return ESP_OK;
+}
+
+/**
+ * @brief Open the host backend, create the RX ring buffer and event queue, and start polling.
+*/
+esp_err_t uart_driver_install(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size,
+                              int queue_size, QueueHandle_t *uart_queue, int intr_alloc_flags)
+{
+    (void)uart_num;
+    (void)tx_buffer_size;
+    (void)intr_alloc_flags;
+
+    if (open_backend() != ESP_OK) {
+        return ESP_FAIL;
+    }
+
+    rx_buffer   = xStreamBufferCreate(rx_buffer_size, 1);
+    event_queue = xQueueCreate(queue_size, sizeof(uart_event_t));
+    if (rx_buffer == NULL || event_queue == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    if (uart_queue != NULL) {
+        *uart_queue = event_queue;
+    }
+
+    if (replay_enabled()) {
+        xTaskCreate(uart_host_replay_task, "uart_host_replay", 8192, NULL, TASK_PRIO_LOW, NULL);
+        return ESP_OK;
+    }
+    xTaskCreate(uart_host_rx_task, "uart_host_rx", 4096, NULL, TASK_PRIO_MAX, NULL);
+    if (CONFIG_GATEWAY_HOST_UART_BENCH_FRAMES > 0) {
+        xTaskCreate(uart_host_bench_task, "uart_host_bench", 4096, NULL, TASK_PRIO_LOW, NULL);
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Read up to length bytes from the RX ring buffer.
+ * @return Number of bytes read, which is less than length only on timeout.
+*/
+int uart_read_bytes(uart_port_t uart_num, void *buf, uint32_t length, TickType_t ticks_to_wait)
+{
+    (void)uart_num;
+
+    uint8_t   *dst   = (uint8_t *)buf;
+    uint32_t   total = 0;
+    TimeOut_t  timeout;
+
+    vTaskSetTimeOutState(&timeout);
+    while (total < length) {
+        total += xStreamBufferReceive(rx_buffer, dst + total, length - total, ticks_to_wait);
+        if (total < length && xTaskCheckForTimeOut(&timeout, &ticks_to_wait) == pdTRUE) {
+            break;
+        }
+    }
+    return (int)total;
+}
+
+/**
+ * @brief Write bytes to the link.
+ * @return Number of bytes written, or -1 on error.
+*/
+int uart_write_bytes(uart_port_t uart_num, const void *src, size_t size)
+{
+    (void)uart_num;
+
+    const uint8_t *p    = (const uint8_t *)src;
+    size_t         left = size;
+    ssize_t        ret;
+
+    while (left > 0) {
+        ret = write(uart_fd, p, left);
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) { vTaskDelay(1); continue; }
+            return -1;
+        }
+        p    += ret;
+        left -= (size_t)ret;
+    }
+    return (int)size;
+}
+
+/** @brief Select and open the backend configured in menuconfig */
+static esp_err_t open_backend(void)
+{
+    if (replay_enabled() || CONFIG_GATEWAY_HOST_UART_BENCH_FRAMES > 0) {
+        int sv[2];
+
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+            ESP_LOGE(TAG, "socketpair failed: %s", strerror(errno));
+            return ESP_FAIL;
+        }
+        uart_fd = sv[0];
+        peer_fd = sv[1];
+        fcntl(peer_fd, F_SETFL, fcntl(peer_fd, F_GETFL) | O_NONBLOCK);
+        if (replay_enabled()) {
+            ESP_LOGI(TAG, "UART2 replaying %s", CONFIG_GATEWAY_HOST_UART_REPLAY_FILE);
+        } else {
+            ESP_LOGI(TAG, "UART2 on socketpair, benchmark of %d frames", CONFIG_GATEWAY_HOST_UART_BENCH_FRAMES);
+        }
+    } else if (strlen(CONFIG_GATEWAY_HOST_UART_DEVICE) > 0) {
+        uart_fd = open_device(CONFIG_GATEWAY_HOST_UART_DEVICE);
+        if (uart_fd < 0) {
+            ESP_LOGE(TAG, "Cannot open %s: %s", CONFIG_GATEWAY_HOST_UART_DEVICE, strerror(errno));
+            return ESP_FAIL;
+        }
+        ESP_LOGI(TAG, "UART2 on %s", CONFIG_GATEWAY_HOST_UART_DEVICE);
+    } else {
+        uart_fd = posix_openpt(O_RDWR | O_NOCTTY);
+        if (uart_fd < 0 || grantpt(uart_fd) != 0 || unlockpt(uart_fd) != 0) {
+            ESP_LOGE(TAG, "Cannot create pseudo-terminal: %s", strerror(errno));
+            return ESP_FAIL;
+        }
+        ESP_LOGI(TAG, "UART2 on %s", ptsname(uart_fd));
+    }
+    fcntl(uart_fd, F_SETFL, fcntl(uart_fd, F_GETFL) | O_NONBLOCK);
+
+    if (!replay_enabled() && strlen(CONFIG_GATEWAY_HOST_UART_CAPTURE_FILE) > 0) {
+        capture_file = uart_capture_create(CONFIG_GATEWAY_HOST_UART_CAPTURE_FILE, baud_rate);
+        if (capture_file == NULL) {
+            ESP_LOGE(TAG, "Cannot create %s: %s", CONFIG_GATEWAY_HOST_UART_CAPTURE_FILE, strerror(errno));
+            return ESP_FAIL;
+        }
+        ESP_LOGI(TAG, "Capturing UART2 RX to %s", CONFIG_GATEWAY_HOST_UART_CAPTURE_FILE);
+    }
+    return ESP_OK;
+}
+
+/** @brief Open a serial device or pty slave in raw mode */
+static int open_device(const char *path)
+{
+    struct termios tio;
+    int fd = open(path, O_RDWR | O_NOCTTY);
+
+    if (fd >= 0 && tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, B115200);
+        cfsetospeed(&tio, B115200);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    return fd;
+}
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000U + (uint64_t)ts.tv_nsec / 1000U;
+}
+
+static uint64_t cpu_time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000U + (uint64_t)ts.tv_nsec / 1000U;
+}
+
+/** @brief Block until deadline (monotonic us), to tick resolution. Returns at once if already past. */
+static void wait_until_us(uint64_t deadline)
+{
+    const uint64_t tick_us = (uint64_t)portTICK_PERIOD_MS * 1000U;
+    uint64_t now = now_us();
+
+    if (deadline > now && deadline - now >= tick_us) {
+        vTaskDelay((TickType_t)((deadline - now) / tick_us));
+    }
+}
+
+/** @brief Read and count pending replies (newline-terminated) sent by uart_rxtx_task */
+static uint32_t drain_replies(void)
+{
+    char reply[128];
+    uint32_t replies = 0;
+    ssize_t n;
+
+    while ((n = read(peer_fd, reply, sizeof(reply))) > 0) {
+        for (ssize_t i = 0; i < n; i++) replies += (reply[i] == '\n');
+    }
+    return replies;
+}
+
+/**
+ * @brief Wait until uart_rxtx_task has stopped consuming input.
+ * @return Bytes left unread in the RX ring buffer.
+ * 
+ * uart_rxtx_task can read less than an event announces, so leftover bytes are
+ * possible; the RX path is idle once the event queue is empty and the ring
+ * buffer level has not moved for UART_HOST_DRAIN_TICKS.
+*/
+static size_t wait_rx_drained(void)
+{
+    size_t level = xStreamBufferBytesAvailable(rx_buffer);
+    uint32_t idle = 0;
+
+    while (idle < UART_HOST_DRAIN_TICKS) {
+        vTaskDelay(1);
+        size_t now = xStreamBufferBytesAvailable(rx_buffer);
+        if (uxQueueMessagesWaiting(event_queue) > 0 || now != level) {
+            level = now;
+            idle  = 0;
+        } else {
+            idle++;
+        }
+    }
+    return level;
+}
+
+/**
+ * @brief Queue one received chunk as a UART_DATA event.
+ * @return false if the ring buffer or event queue stayed full for ticks_to_wait.
+ * 
+ * Like the hardware driver, a UART_BUFFER_FULL event is posted when the chunk does
+ * not fit in the RX ring buffer; the chunk is then held until enough space frees up.
+*/
+static bool rx_push(const uint8_t *data, size_t length, TickType_t ticks_to_wait)
+{
+    uart_event_t event = { .type = UART_BUFFER_FULL };
+    TimeOut_t timeout;
+
+    vTaskSetTimeOutState(&timeout);
+    if (xStreamBufferSpacesAvailable(rx_buffer) < length) {
+        xQueueSend(event_queue, &event, 0);
+        while (xStreamBufferSpacesAvailable(rx_buffer) < length) {
+            if (xTaskCheckForTimeOut(&timeout, &ticks_to_wait) == pdTRUE) return false;
+            vTaskDelay(1);
+        }
+    }
+    xStreamBufferSend(rx_buffer, data, length, 0);
+
+    event.type = UART_DATA;
+    event.size = length;
+    return xQueueSend(event_queue, &event, ticks_to_wait) == pdTRUE;
+}
+
+/**
+ * @brief Stand-in for the UART RX ISR.
+ * 
+ * Polls the backend, copies each chunk into the RX ring buffer and posts a UART_DATA
+ * event for it. Holds the chunk, rather than dropping it, while the ring buffer is full.
+*/
+static void uart_host_rx_task(void *pvParameters)
+{
+    (void)pvParameters;
+
+    uint8_t chunk[UART_HOST_RX_CHUNK];
+    uint64_t last_us = now_us();
+    ssize_t n;
+
+    while (1) {
+        n = read(uart_fd, chunk, sizeof(chunk));
+        if (n <= 0) {
+            vTaskDelay(1);      // Nothing pending (EAGAIN) or peer not attached (EIO)
+            continue;
+        }
+
+        if (capture_file != NULL) {
+            uint64_t t = now_us();
+            uart_capture_write(capture_file, (uint32_t)(t - last_us), chunk, (uint16_t)n);
+            fflush(capture_file);
+            last_us = t;
+        }
+
+        rx_push(chunk, (size_t)n, portMAX_DELAY);
+    }
+}
+
+/**
+ * @brief Benchmark generator: feeds back-to-back frames into the RX path in full
+ *        RX chunks, waits for uart_rxtx_task to go idle and logs the rate.
+*/
+static void uart_host_bench_task(void *pvParameters)
+{
+    (void)pvParameters;
+
+    const char *frame     = UART_HOST_BENCH_FRAME;
+    const size_t frame_len = strlen(frame);
+    const uint32_t frames  = CONFIG_GATEWAY_HOST_UART_BENCH_FRAMES;
+    uint8_t chunk[UART_HOST_RX_CHUNK];
+    size_t fill = 0;
+    uint32_t sent = 0, replies = 0;
+    bool stalled = false;
+    TickType_t start = xTaskGetTickCount();
+
+    while (sent < frames && !stalled) {
+        for (size_t i = 0; i < frame_len && !stalled; i++) {
+            chunk[fill++] = (uint8_t)frame[i];
+            if (fill == sizeof(chunk)) {
+                stalled = !rx_push(chunk, fill, UART_HOST_STALL_TICKS);
+                fill    = 0;
+            }
+        }
+        sent++;
+        replies += drain_replies();
+    }
+    if (fill > 0 && !stalled) {
+        stalled = !rx_push(chunk, fill, UART_HOST_STALL_TICKS);
+    }
+    if (stalled) {
+        ESP_LOGE(TAG, "Bench: RX path stalled after %lu frames, %u bytes unread",
+                 (unsigned long)sent, (unsigned)xStreamBufferBytesAvailable(rx_buffer));
+        vTaskDelete(NULL);
+    }
+
+    // Wait until the gateway has consumed everything it is going to
+    size_t unread = wait_rx_drained();
+    replies += drain_replies();
+
+    TickType_t elapsed = xTaskGetTickCount() - start - UART_HOST_DRAIN_TICKS;
+    uint32_t ms = (uint32_t)(elapsed * portTICK_PERIOD_MS);
+    ESP_LOGI(TAG, "Bench: %lu frames (%lu bytes) in %lu ms, %lu replies, %u bytes unread, %lu frames/s",
+             (unsigned long)sent, (unsigned long)(sent * frame_len), (unsigned long)ms,
+             (unsigned long)replies, (unsigned)unread,
+             (unsigned long)(ms > 0 ? (uint64_t)sent * 1000U / ms : 0));
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Replay a .ucap capture into the RX path.
+ * 
+ * Each record is split into UART_DATA events of CONFIG_GATEWAY_HOST_UART_REPLAY_CHUNK
+ * bytes, or kept at its recorded boundaries (capped at the RX chunk size) when 0.
+ * Events are paced by the recorded inter-chunk gaps, by the baud rate, or not at
+ * all, then the wall and CPU time spent until uart_rxtx_task goes idle is logged
+ * per byte. In fast mode that is the cost of the RX path, parser included.
+*/
+static void uart_host_replay_task(void *pvParameters)
+{
+    (void)pvParameters;
+
+    static uint8_t record_buf[UART_CAPTURE_MAX_RECORD];
+    const size_t chunk_max = (CONFIG_GATEWAY_HOST_UART_REPLAY_CHUNK > 0) ?
+                             CONFIG_GATEWAY_HOST_UART_REPLAY_CHUNK : UART_HOST_RX_CHUNK;
+    uart_capture_header_t header;
+    uart_capture_record_t record;
+    uint64_t bytes = 0, events = 0, records = 0;
+    uint32_t replies = 0;
+    int ret = 0;
+
+    uint64_t start_us  = now_us();
+    uint64_t start_cpu = cpu_time_us();
+    uint64_t deadline  = start_us;
+
+    for (int loop = 0; loop < CONFIG_GATEWAY_HOST_UART_REPLAY_LOOPS && ret >= 0; loop++) {
+        FILE *file = uart_capture_open(CONFIG_GATEWAY_HOST_UART_REPLAY_FILE, &header);
+        if (file == NULL) {
+            ESP_LOGE(TAG, "Cannot open %s as a capture", CONFIG_GATEWAY_HOST_UART_REPLAY_FILE);
+            break;
+        }
+
+        while (ret >= 0 && (ret = uart_capture_read(file, &record, record_buf, sizeof(record_buf))) > 0) {
+            if (UART_HOST_REPLAY_PACE_RECORDED) {
+                deadline += record.delta_us;
+                wait_until_us(deadline);
+            }
+            records++;
+            for (size_t off = 0, chunk; off < record.length; off += chunk) {
+                chunk = record.length - off;
+                if (chunk > chunk_max) chunk = chunk_max;
+
+                if (UART_HOST_REPLAY_PACE_WIRE) {
+                    deadline += (uint64_t)chunk * UART_HOST_BITS_PER_BYTE * 1000000U /
+                                (header.baud_rate ? header.baud_rate : baud_rate);
+                    wait_until_us(deadline);
+                }
+                if (!rx_push(&record_buf[off], chunk, UART_HOST_STALL_TICKS)) {
+                    ret = -1;
+                    break;
+                }
+                bytes += chunk;
+                events++;
+            }
+            replies += drain_replies();
+        }
+        if (ret < 0) {
+            ESP_LOGE(TAG, "Replay stopped after %llu bytes: bad record or RX path stalled (%u bytes unread)",
+                     (unsigned long long)bytes, (unsigned)xStreamBufferBytesAvailable(rx_buffer));
+        }
+        fclose(file);
+    }
+
+    size_t unread = wait_rx_drained();
+    uint64_t wall_us = now_us() - start_us - (uint64_t)UART_HOST_DRAIN_TICKS * portTICK_PERIOD_MS * 1000U;
+    uint64_t cpu_us  = cpu_time_us() - start_cpu;
+    replies += drain_replies();
+
+    ESP_LOGI(TAG, "Replay: %llu records, %llu events, %llu bytes, %lu replies, %u bytes unread",
+             (unsigned long long)records, (unsigned long long)events, (unsigned long long)bytes,
+             (unsigned long)replies, (unsigned)unread);
+    ESP_LOGI(TAG, "Replay: %llu us wall (%llu ns/byte), %llu us cpu (%llu ns/byte)",
+             (unsigned long long)wall_us, (unsigned long long)(bytes ? wall_us * 1000U / bytes : 0),
+             (unsigned long long)cpu_us,  (unsigned long long)(bytes ? cpu_us * 1000U / bytes : 0));
+    vTaskDelete(NULL);
+}
@@ -0,0 +1,134 @@
+/**
+ * @file bench_uart_protocol.c
+ * @brief Throughput of the UART protocol parser (uart_protocol.c) per event size.
+ *
+ * Feeds a few MB of STM32-shaped traffic (READY?/Message handshakes and Transmit
+ * log lines) in slices of 1 byte up to the whole stream, as UART_DATA events of
+ * different sizes would. Reports ns/byte, MB/s and the headroom over a 115200 baud
+ * link, and checks that every frame is recognized at every slice size.
+ *
+ *   bench_uart_protocol [MB]
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "uart_protocol.h"
+
+#define UART_BAUD           (115200U)
+#define UART_BITS_PER_BYTE  (10U)       // 8N1
+#define BENCH_MIN_NS        (200000000ULL)  // Repeat each case for at least 0.2 s
+
+typedef struct {
+    uint64_t frames;
+    uint64_t replies;
+} bench_counts_t;
+
+static void count_frame(uart_cmd_t cmd, const char *line, size_t len, void *ctx)
+{
+    bench_counts_t *counts = ctx;
+    (void)line;
+    (void)len;
+    counts->frames++;
+    if (uart_proto_reply(cmd) != NULL) {
+        counts->replies++;
+    }
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/** @brief Fill buf with STM32 traffic; returns the byte count and the frame counts */
+static size_t make_stream(uint8_t *buf, size_t cap, bench_counts_t *expected)
+{
+    char line[UART_PROTO_LINE_MAX];
+    size_t len = 0;
+    uint32_t seq = 0;
+
+    memset(expected, 0, sizeof(*expected));
+    while (1) {
+        int n;
+        switch (seq % 3) {
+        case 0:  n = snprintf(line, sizeof(line), "READY?\n"); break;
+        case 1:  n = snprintf(line, sizeof(line), "Message from STM32\n"); break;
+        default: n = snprintf(line, sizeof(line),
+                              "[Transmit    ] Transmit to ESP32: Temp: %3u  Motion: %u  Timestamp: %u\n",
+                              (unsigned)(seq % 100), (unsigned)(seq & 1), (unsigned)(seq * 10)); break;
+        }
+        if (len + (size_t)n > cap) {
+            break;
+        }
+        memcpy(&buf[len], line, (size_t)n);
+        len += (size_t)n;
+        expected->frames++;
+        if (seq % 3 != 2) {
+            expected->replies++;
+        }
+        seq++;
+    }
+    return len;
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t slices[] = { 1, 8, 39, 120, 1024, 0 };     // 0 = whole stream
+    size_t mb = (argc > 1) ? strtoul(argv[1], NULL, 0) : 4;
+    size_t cap = (mb > 0 ? mb : 1) << 20;
+    uint8_t *stream = malloc(cap);
+    bench_counts_t expected;
+    size_t size;
+    double uart_bytes_per_s = (double)UART_BAUD / UART_BITS_PER_BYTE;
+    int failed = 0;
+
+    if (stream == NULL) {
+        return 2;
+    }
+    size = make_stream(stream, cap, &expected);
+
+    printf("%zu bytes, %llu frames per pass\n", size, (unsigned long long)expected.frames);
+    printf("%-10s %10s %10s %14s %10s\n", "slice", "ns/byte", "MB/s", "x 115200 baud", "frames");
+
+    for (size_t s = 0; s < sizeof(slices) / sizeof(slices[0]); s++) {
+        size_t slice = (slices[s] == 0) ? size : slices[s];
+        uint64_t passes = 0;
+        uint64_t start = now_ns();
+        uint64_t elapsed;
+        bench_counts_t counts = {0};
+        uart_proto_t proto;
+
+        do {
+            uart_proto_init(&proto);
+            for (size_t off = 0; off < size; off += slice) {
+                size_t n = (size - off < slice) ? size - off : slice;
+                uart_proto_feed(&proto, &stream[off], n, count_frame, &counts);
+            }
+            passes++;
+            elapsed = now_ns() - start;
+        } while (elapsed < BENCH_MIN_NS);
+
+        double ns_per_byte = (double)elapsed / ((double)size * (double)passes);
+        char label[24];
+        if (slices[s] == 0) {
+            snprintf(label, sizeof(label), "all");
+        } else {
+            snprintf(label, sizeof(label), "%zu", slices[s]);
+        }
+        printf("%-10s %10.2f %10.1f %14.0f %10llu%s\n", label, ns_per_byte, 1e3 / ns_per_byte,
+               1e9 / ns_per_byte / uart_bytes_per_s, (unsigned long long)(counts.frames / passes),
+               (counts.frames != expected.frames * passes || counts.replies != expected.replies * passes)
+                   ? "  MISMATCH" : "");
+        if (counts.frames != expected.frames * passes || counts.replies != expected.replies * passes) {
+            failed = 1;
+        }
+    }
+
+    free(stream);
+    return failed;
+}
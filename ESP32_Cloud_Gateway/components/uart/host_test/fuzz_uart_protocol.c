@@ -0,0 +1,308 @@
+/**
+ * @file fuzz_uart_protocol.c
+ * @brief Differential fuzzer for the UART protocol parser (uart_protocol.c).
+ *
+ * Each input is a byte stream from the STM32. It is fed to the parser three ways:
+ * in one call, byte by byte, and in pseudo-random fragments. The fragmented feed is
+ * also run with a stall at a random point, as after UART_BUFFER_FULL (the bytes are
+ * held and delivered later, so nothing is lost and the frames must not change), and
+ * with a resync at a random point, as after UART_FIFO_OVF (bytes were lost). Every
+ * run must deliver exactly the frames of a simple reference implementation, and every
+ * delivered frame must satisfy the parser's contract. Any mismatch aborts.
+ *
+ * Built against libFuzzer when the compiler is clang (UART_PROTO_LIBFUZZER).
+ * Otherwise a standalone driver runs the corpus files given on the command line,
+ * then -runs=N generated streams of valid, damaged and random frames:
+ *   fuzz_uart_protocol [-runs=N] [-seed=S] [corpus files...]
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "uart_protocol.h"
+
+#define NO_RESYNC       SIZE_MAX
+
+/** @brief Frames delivered by one run, serialized as cmd | len (2 bytes) | line */
+typedef struct {
+    uint8_t *data;
+    size_t   len;
+    size_t   cap;
+} frame_log_t;
+
+static uint32_t rng_state;
+
+static uint32_t rng_next(void)
+{
+    // xorshift32: deterministic per input, so failures reproduce
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void log_frame(frame_log_t *log, uart_cmd_t cmd, const char *line, size_t len)
+{
+    if (log->len + 3 + len > log->cap) {
+        fprintf(stderr, "frame log overflow\n");
+        abort();
+    }
+    log->data[log->len++] = (uint8_t)cmd;
+    log->data[log->len++] = (uint8_t)(len & 0xFF);
+    log->data[log->len++] = (uint8_t)(len >> 8);
+    memcpy(&log->data[log->len], line, len);
+    log->len += len;
+}
+
+/** @brief Parser callback: check the frame contract, then log the frame */
+static void on_frame(uart_cmd_t cmd, const char *line, size_t len, void *ctx)
+{
+    if (len > UART_PROTO_LINE_MAX || line[len] != '\0' || memchr(line, '\n', len) != NULL) {
+        fprintf(stderr, "frame contract violated (cmd %d, len %zu)\n", (int)cmd, len);
+        abort();
+    }
+    if (cmd != UART_CMD_OVERFLOW && cmd != uart_proto_classify(line, len)) {
+        fprintf(stderr, "frame misclassified (cmd %d)\n", (int)cmd);
+        abort();
+    }
+    if (cmd == UART_CMD_OVERFLOW && len != UART_PROTO_LINE_MAX) {
+        fprintf(stderr, "overflow frame of %zu bytes\n", len);
+        abort();
+    }
+    log_frame((frame_log_t *)ctx, cmd, line, len);
+}
+
+/**
+ * @brief Reference framing, written for clarity rather than speed.
+ *
+ * The frame that spans offset `resync` (bytes on both sides of it) is dropped.
+*/
+static void reference_parse(const uint8_t *data, size_t size, size_t resync, frame_log_t *log)
+{
+    size_t start = 0;
+
+    for (size_t i = 0; i < size; i++) {
+        if (data[i] != '\n') {
+            continue;
+        }
+
+        size_t raw = i - start;
+        size_t len = raw;
+        bool cut = (resync != NO_RESYNC && start < resync && resync <= i);
+
+        if (!cut && len > 0) {
+            if (raw > UART_PROTO_LINE_MAX) {
+                log_frame(log, UART_CMD_OVERFLOW, (const char *)&data[start], UART_PROTO_LINE_MAX);
+            } else {
+                if (data[start + len - 1] == '\r') {
+                    len--;
+                }
+                if (len > 0) {
+                    log_frame(log, uart_proto_classify((const char *)&data[start], len),
+                              (const char *)&data[start], len);
+                }
+            }
+        }
+        start = i + 1;
+    }
+}
+
+/**
+ * @brief Feed data in fragments of 1..max_chunk bytes, one of them ending at offset split.
+ *
+ * With resync, uart_proto_resync() is called at the split, as after UART_FIFO_OVF.
+ * Without it the split is only a stall in delivery, as after UART_BUFFER_FULL.
+*/
+static void fragmented_parse(const uint8_t *data, size_t size, size_t max_chunk, size_t split,
+                             bool resync, frame_log_t *log)
+{
+    uart_proto_t proto;
+    size_t offset = 0;
+
+    uart_proto_init(&proto);
+    while (offset < size) {
+        size_t chunk = 1 + (rng_next() % max_chunk);
+        if (chunk > size - offset) {
+            chunk = size - offset;
+        }
+        if (split != NO_RESYNC && offset < split && split < offset + chunk) {
+            chunk = split - offset;             // End the slice at the split point
+        }
+        uart_proto_feed(&proto, &data[offset], chunk, on_frame, log);
+        offset += chunk;
+        if (resync && offset == split) {
+            uart_proto_resync(&proto);
+        }
+    }
+}
+
+static void expect_equal(const frame_log_t *a, const frame_log_t *b, const char *what)
+{
+    if (a->len != b->len || memcmp(a->data, b->data, a->len) != 0) {
+        fprintf(stderr, "%s: frames differ from the reference (%zu vs %zu bytes)\n", what, a->len, b->len);
+        abort();
+    }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    uart_proto_t proto;
+    frame_log_t expected, actual;
+    size_t cap = 3 * size + 16;
+    size_t split;
+
+    expected.data = malloc(cap);
+    actual.data   = malloc(cap);
+    expected.cap  = cap;
+    actual.cap    = cap;
+    if (expected.data == NULL || actual.data == NULL) {
+        abort();
+    }
+
+    rng_state = 0x9E3779B9u ^ (uint32_t)size ^ (size > 0 ? (uint32_t)data[0] << 8 : 0u);
+
+    // Whole stream in one call
+    expected.len = 0;
+    reference_parse(data, size, NO_RESYNC, &expected);
+    actual.len = 0;
+    uart_proto_init(&proto);
+    uart_proto_feed(&proto, data, size, on_frame, &actual);
+    expect_equal(&actual, &expected, "single feed");
+
+    // One byte per call
+    actual.len = 0;
+    uart_proto_init(&proto);
+    for (size_t i = 0; i < size; i++) {
+        uart_proto_feed(&proto, &data[i], 1, on_frame, &actual);
+    }
+    expect_equal(&actual, &expected, "byte feed");
+
+    // Random fragments, plain, with a buffer-full stall and with a FIFO-overflow resync
+    actual.len = 0;
+    fragmented_parse(data, size, 1 + (rng_next() % 200), NO_RESYNC, false, &actual);
+    expect_equal(&actual, &expected, "fragmented feed");
+
+    if (size > 0) {
+        split = rng_next() % size;
+        actual.len = 0;
+        fragmented_parse(data, size, 1 + (rng_next() % 64), split, false, &actual);
+        expect_equal(&actual, &expected, "buffer-full feed");
+
+        expected.len = 0;
+        reference_parse(data, size, split, &expected);
+        actual.len = 0;
+        fragmented_parse(data, size, 1 + (rng_next() % 64), split, true, &actual);
+        expect_equal(&actual, &expected, "resync feed");
+    }
+
+    free(expected.data);
+    free(actual.data);
+    return 0;
+}
+
+#if !defined(UART_PROTO_LIBFUZZER)
+
+static const char *const frame_pool[] = {
+    "READY?\n",
+    "Message from STM32\n",
+    "READY?\r\n",
+    "[Transmit    ] Transmit to ESP32: Temp:  42  Motion: 1  Timestamp: 10062\n",
+    "\n",
+    "\r\n",
+    "READY",
+    "Message from",
+};
+
+/** @brief Build a stream of valid, truncated, oversized and random frames */
+static size_t generate(uint8_t *buf, size_t cap)
+{
+    size_t len = 0;
+    size_t target = rng_next() % cap;
+
+    while (len < target) {
+        uint32_t pick = rng_next() % 10;
+
+        if (pick < 6) {
+            const char *frame = frame_pool[rng_next() % (sizeof(frame_pool) / sizeof(frame_pool[0]))];
+            size_t n = strlen(frame);
+            if (len + n > cap) break;
+            memcpy(&buf[len], frame, n);
+            len += n;
+        } else if (pick < 9) {
+            size_t n = rng_next() % 16;
+            for (size_t i = 0; i < n && len < cap; i++) {
+                buf[len++] = (uint8_t)rng_next();
+            }
+        } else {
+            size_t n = UART_PROTO_LINE_MAX - 2 + (rng_next() % 6);     // Around the length limit
+            for (size_t i = 0; i < n && len < cap; i++) {
+                buf[len++] = 'x';
+            }
+            if (len < cap && (rng_next() & 1)) buf[len++] = '\r';
+            if (len < cap) buf[len++] = '\n';
+        }
+    }
+    return len;
+}
+
+static int run_file(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    uint8_t *buf;
+    long size;
+
+    if (f == NULL || fseek(f, 0, SEEK_END) != 0 || (size = ftell(f)) < 0) {
+        fprintf(stderr, "cannot read %s\n", path);
+        if (f != NULL) fclose(f);
+        return -1;
+    }
+    rewind(f);
+    buf = malloc((size_t)size + 1);
+    if (buf == NULL || fread(buf, 1, (size_t)size, f) != (size_t)size) {
+        fprintf(stderr, "cannot read %s\n", path);
+        fclose(f);
+        free(buf);
+        return -1;
+    }
+    fclose(f);
+
+    LLVMFuzzerTestOneInput(buf, (size_t)size);
+    free(buf);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    static uint8_t buf[8192];
+    unsigned long runs = 100000;
+    uint32_t seed = 1;
+    int files = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-runs=", 6) == 0) {
+            runs = strtoul(argv[i] + 6, NULL, 0);
+        } else if (strncmp(argv[i], "-seed=", 6) == 0) {
+            seed = (uint32_t)strtoul(argv[i] + 6, NULL, 0);
+        } else {
+            if (run_file(argv[i]) != 0) {
+                return 1;
+            }
+            files++;
+        }
+    }
+
+    for (unsigned long r = 0; r < runs; r++) {
+        rng_state = seed + (uint32_t)r * 2654435761u;
+        if (rng_state == 0) rng_state = 1;
+        size_t len = generate(buf, sizeof(buf));
+        LLVMFuzzerTestOneInput(buf, len);
+    }
+
+    printf("fuzz_uart_protocol: %d corpus files, %lu generated streams, no mismatch\n", files, runs);
+    return 0;
+}
+
+#endif /* !UART_PROTO_LIBFUZZER */
@@ -15,7 +15,7 @@
 #define UART_2_RX 16
 #define UART_NUM2 UART_NUM_2
 #define BUF_SIZE 1024
-#define RX_BUF_SIZE 40  // Fixed buffer size for incoming data
+#define RX_BUF_SIZE 128 // Read size per uart_read_bytes() call; frames are reassembled by uart_protocol.c
 
 extern QueueHandle_t uart_2_queue;
 
@@ -0,0 +1,60 @@
+#ifndef UART_PROTOCOL_H
+#define UART_PROTOCOL_H
+
+/**
+ * @file uart_protocol.h
+ * @brief Streaming parser for the STM32 -> ESP32 UART protocol.
+ *
+ * The STM32 sends newline-terminated text frames ("READY?\n", "Message from STM32\n").
+ * UART events carry arbitrary slices of that stream: a frame can be split over
+ * several events and one event can hold several frames. uart_proto_feed() accepts
+ * any slice, reassembles frames across calls and reports each complete frame once.
+ *
+ * The parser has no FreeRTOS or driver dependencies, so it can be fuzzed and
+ * benchmarked on the host (see components/uart/host_test/).
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define UART_PROTO_LINE_MAX     (128U)  // Longest frame kept, without '\n' (STM32 LOG_MSG_MAX_LEN)
+
+/** @brief Frame types */
+typedef enum {
+    UART_CMD_READY = 0,                 // "READY?" handshake, answered with "OK"
+    UART_CMD_MESSAGE,                   // "Message from STM32", answered with "ACK"
+    UART_CMD_UNKNOWN,                   // Any other frame
+    UART_CMD_OVERFLOW,                  // Frame longer than UART_PROTO_LINE_MAX, discarded
+} uart_cmd_t;
+
+/**
+ * @brief Called once per complete frame.
+ *
+ * @param cmd   Frame type.
+ * @param line  Frame without the terminating "\n" or "\r\n", NUL-terminated
+ *              (for UART_CMD_OVERFLOW, the first UART_PROTO_LINE_MAX bytes).
+ * @param len   Length of line.
+ * @param ctx   Context passed to uart_proto_feed().
+*/
+typedef void (*uart_proto_handler_t)(uart_cmd_t cmd, const char *line, size_t len, void *ctx);
+
+/** @brief Parser state, one per UART link */
+typedef struct {
+    char     line[UART_PROTO_LINE_MAX + 1U];   /**< Frame being assembled, NUL-terminated on delivery */
+    size_t   len;                               /**< Bytes of the current frame in line */
+    bool     overflow;                          /**< Current frame is longer than UART_PROTO_LINE_MAX */
+    bool     discarding;                        /**< Current frame lost bytes (uart_proto_resync); drop it */
+    uint32_t frames;                            /**< Frames delivered, including unknown ones */
+    uint32_t overflows;                         /**< Frames discarded for being too long */
+} uart_proto_t;
+
+// Function Prototype
+void uart_proto_init(uart_proto_t *proto);
+size_t uart_proto_feed(uart_proto_t *proto, const uint8_t *data, size_t length,
+                       uart_proto_handler_t handler, void *ctx);
+void uart_proto_resync(uart_proto_t *proto);
+uart_cmd_t uart_proto_classify(const char *line, size_t len);
+const char *uart_proto_reply(uart_cmd_t cmd);
+
+#endif  // UART_PROTOCOL_H
@@ -0,0 +1,137 @@
+/**
+ * @file uart_protocol.c
+ * @brief Streaming parser for the STM32 -> ESP32 UART protocol.
+ * 
+ * Frames end at '\n'; a trailing '\r' is dropped and empty frames are ignored.
+ * Each slice is scanned with memchr() and copied in one piece per frame, so the
+ * cost per byte stays flat whether events carry one byte or a full ring buffer.
+*/
+
+#include <string.h>
+
+#include "uart_protocol.h"
+
+#define CMD_READY       "READY?"
+#define CMD_MESSAGE     "Message from STM32"
+
+// Local function prototypes
+static void deliver(uart_proto_t *proto, uart_proto_handler_t handler, void *ctx);
+
+void uart_proto_init(uart_proto_t *proto)
+{
+    memset(proto, 0, sizeof(*proto));
+}
+
+/**
+ * @brief Parse a slice of the received byte stream.
+ * 
+ * @param proto    Parser state.
+ * @param data     Received bytes (any content, including NUL).
+ * @param length   Number of bytes in data.
+ * @param handler  Called for every frame completed by this slice (may be NULL).
+ * @param ctx      Passed to handler.
+ * @return Number of frames completed by this slice.
+*/
+size_t uart_proto_feed(uart_proto_t *proto, const uint8_t *data, size_t length,
+                       uart_proto_handler_t handler, void *ctx)
+{
+    size_t completed = 0;
+
+    while (length > 0) {
+        const uint8_t *eol = memchr(data, '\n', length);
+        size_t chunk = (eol != NULL) ? (size_t)(eol - data) : length;
+
+        // Append what fits; anything beyond UART_PROTO_LINE_MAX only marks the frame as too long
+        if (!proto->discarding && !proto->overflow) {
+            size_t room = UART_PROTO_LINE_MAX - proto->len;
+            size_t copy = (chunk < room) ? chunk : room;
+
+            memcpy(&proto->line[proto->len], data, copy);
+            proto->len += copy;
+            if (copy < chunk) {
+                proto->overflow = true;
+            }
+        }
+
+        if (eol == NULL) {
+            break;
+        }
+
+        if (!proto->overflow && proto->len > 0 && proto->line[proto->len - 1] == '\r') {
+            proto->len--;
+        }
+
+        if (proto->discarding) {
+            proto->discarding = false;
+        } else if (proto->overflow || proto->len > 0) {
+            deliver(proto, handler, ctx);
+            completed++;
+        }
+        proto->len = 0;
+        proto->overflow = false;
+
+        data   += chunk + 1;
+        length -= chunk + 1;
+    }
+
+    return completed;
+}
+
+/**
+ * @brief Drop the frame in progress after received bytes were lost.
+ * 
+ * Call when the driver reports UART_FIFO_OVF (UART_BUFFER_FULL loses no bytes). If a frame was
+ * being assembled, it is discarded up to its '\n' instead of being delivered
+ * with a hole in it.
+*/
+void uart_proto_resync(uart_proto_t *proto)
+{
+    if (proto->len > 0 || proto->overflow) {
+        proto->discarding = true;
+    }
+    proto->len = 0;
+    proto->overflow = false;
+}
+
+/** @brief Frame type of a complete frame (prefix match, as the STM32 may append text) */
+uart_cmd_t uart_proto_classify(const char *line, size_t len)
+{
+    if (len >= sizeof(CMD_READY) - 1 && memcmp(line, CMD_READY, sizeof(CMD_READY) - 1) == 0) {
+        return UART_CMD_READY;
+    }
+    if (len >= sizeof(CMD_MESSAGE) - 1 && memcmp(line, CMD_MESSAGE, sizeof(CMD_MESSAGE) - 1) == 0) {
+        return UART_CMD_MESSAGE;
+    }
+    return UART_CMD_UNKNOWN;
+}
+
+/** @brief Reply the gateway sends for a frame type, or NULL for none */
+const char *uart_proto_reply(uart_cmd_t cmd)
+{
+    switch (cmd) {
+    case UART_CMD_READY:    return "OK\n";
+    case UART_CMD_MESSAGE:  return "ACK\n";
+    default:                return NULL;
+    }
+}
+
+/** @brief Terminate the assembled frame and hand it to the handler */
+static void deliver(uart_proto_t *proto, uart_proto_handler_t handler, void *ctx)
+{
+    uart_cmd_t cmd;
+    size_t len = proto->len;
+
+    proto->line[len] = '\0';
+
+    if (proto->overflow) {
+        cmd = UART_CMD_OVERFLOW;
+        proto->overflows++;
+    } else {
+        cmd = uart_proto_classify(proto->line, len);
+    }
+    proto->frames++;
+
+    if (handler != NULL) {
+        handler(cmd, proto->line, len, ctx);
+    }
+}
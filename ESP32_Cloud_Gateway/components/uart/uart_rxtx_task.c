@@ -1,6 +1,10 @@
 /**
  * @file uart_rxtx_task.c
- * @brief 
+ * @brief UART2 receive task: frames the STM32 byte stream and answers each command.
+ *
+ * Every UART_DATA event is read in full and fed to the streaming parser in
+ * uart_protocol.c, so frames split over several events or merged into one are
+ * handled alike.
 */
 
 #include "freertos/FreeRTOS.h"
@@ -11,49 +15,73 @@
 #include "stdio.h"
 
 #include "uart.h"
+#include "uart_protocol.h"
 #include "task_priorities.h"
 
+// Local function prototypes
+static void handle_frame(uart_cmd_t cmd, const char *line, size_t len, void *ctx);
+
 static void rxtx_task(void *pvParameters)
 {
     uart_event_t event;
-    uint8_t rx_data[RX_BUF_SIZE] = {0};
+    uart_proto_t proto;
+    uint8_t rx_data[RX_BUF_SIZE];
+
+    uart_proto_init(&proto);
 
     while (1) {
         if (xQueueReceive(uart_2_queue, (void *)&event, portMAX_DELAY)) {
             if (event.type == UART_DATA) {
-                // Clear buffer before reading
-                memset(rx_data, 0, sizeof(rx_data));
-                
-                // Read data (limit to buffer size - 1 to keep null-terminated)
-                int to_read = (event.size < sizeof(rx_data)-1) ? event.size : sizeof(rx_data)-1;
-                uart_read_bytes(UART_NUM2, rx_data, to_read, portMAX_DELAY);
-                
-                // Print received data
-                printf("Received: %s\n", rx_data);
-
-                // Handle protocol commands
-                if (strncmp((char*)rx_data, "READY?", 6) == 0) {
-                    // Send "OK" when STM32 sends "READY?"
-                    const char *response_ok = "OK\n";
-                    uart_write_bytes(UART_NUM2, response_ok, strlen(response_ok));
-                    printf("Responded with: OK\n");
-                } 
-                else if (strncmp((char*)rx_data, "Message from STM32", 18) == 0) {
-                    // Send "ACK" when STM32 sends message
-                    const char *ack_response = "ACK\n";
-                    uart_write_bytes(UART_NUM2, ack_response, strlen(ack_response));
-                    printf("Responded with: ACK\n\n");
-                }
-                else {
-                    printf("Unknown data received.\n\n");
+                // Read the whole event, a buffer at a time
+                size_t remaining = event.size;
+                while (remaining > 0) {
+                    uint32_t to_read = (remaining < sizeof(rx_data)) ? remaining : sizeof(rx_data);
+                    int read = uart_read_bytes(UART_NUM2, rx_data, to_read, portMAX_DELAY);
+                    if (read <= 0) {
+                        break;
+                    }
+                    uart_proto_feed(&proto, rx_data, (size_t)read, handle_frame, NULL);
+                    remaining -= (size_t)read;
                 }
             }
+            else if (event.type == UART_FIFO_OVF) {
+                // Received bytes were lost: do not answer a frame with a hole in it
+                printf("RX FIFO overflow, resynchronizing.\n\n");
+                uart_proto_resync(&proto);
+            }
+            else if (event.type == UART_BUFFER_FULL) {
+                // No bytes lost: the driver holds them until the ring buffer drains
+                printf("RX buffer full.\n\n");
+            }
         }
     }
     vTaskDelete(NULL);
 }
 
+/** @brief Print one received frame and send the matching reply */
+static void handle_frame(uart_cmd_t cmd, const char *line, size_t len, void *ctx)
+{
+    (void)ctx;
+    const char *reply = uart_proto_reply(cmd);
+
+    printf("Received: %.*s\n", (int)len, line);
+
+    if (reply != NULL) {
+        uart_write_bytes(UART_NUM2, reply, strlen(reply));
+        printf("Responded with: %.*s\n", (int)(strlen(reply) - 1), reply);
+        if (cmd == UART_CMD_MESSAGE) {
+            printf("\n");
+        }
+    }
+    else if (cmd == UART_CMD_OVERFLOW) {
+        printf("Frame longer than %u bytes dropped.\n\n", (unsigned)UART_PROTO_LINE_MAX);
+    }
+    else {
+        printf("Unknown data received.\n\n");
+    }
+}
+
 void uart_rxtx_task_init(void)
 {
     xTaskCreate(rxtx_task, "uart_rxtx_task", 2048, NULL, TASK_PRIO_CRITICAL, NULL);
-}
\ No newline at end of file
+}
@@ -0,0 +1,54 @@
+/**
+ * @file wifi_driver_host.c
+ * @brief Host (linux target) Wi-Fi stand-in.
+ * 
+ * The workstation's network is used directly, so the link is reported as
+ * connected from the start and the manager task has nothing to supervise.
+*/
+
+#include <stdbool.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "esp_log.h"
+
+#include "wifi.h"
+
+static const char *TAG = "WIFI_HOST";
+
+// Event group used to signal Wi-Fi connection status
+static EventGroupHandle_t wifi_event_group;
+#define WIFI_CONNECTED_BIT      BIT0    // Bit set when Wi-Fi is connected
+
+void wifi_init(void)
+{
+    wifi_event_group = xEventGroupCreate();
+}
+
+void wifi_start(void)
+{
+    xEventGroupSetBits(wifi_event_group, WIFI_CONNECTED_BIT);
+}
+
+void wifi_stop(void)
+{
+    xEventGroupClearBits(wifi_event_group, WIFI_CONNECTED_BIT);
+}
+
+bool wifi_is_connected(void)
+{
+    EventBits_t bits = xEventGroupGetBits(wifi_event_group);
+    return (bits & WIFI_CONNECTED_BIT) != 0;
+}
+
+void wifi_wait_until_connected(void)
+{
+    xEventGroupWaitBits(wifi_event_group, WIFI_CONNECTED_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+}
+
+void wifi_manager_task_init(void)
+{
+    wifi_init();
+    wifi_start();
+    ESP_LOGI(TAG, "Host build: using the workstation network");
+}
@@ -6,10 +6,12 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_system.h"
-#include "nvs_flash.h"
 #include "esp_event.h"
-#include "esp_netif.h"
 #include "esp_err.h"
+#if !CONFIG_IDF_TARGET_LINUX
+#include "nvs_flash.h"
+#include "esp_netif.h"
+#endif
 #include "esp_log.h"
 #include "string.h"
 #include "stdio.h"
@@ -36,9 +38,13 @@ void app_main()
      *               initialize an application event's callback function
      * 
      *   These are used by: Wi-Fi driver, MQTT driver, 
+     * 
+     *   The host build (linux target) has no NVS or network interface to bring up.
     */
+#if !CONFIG_IDF_TARGET_LINUX
     ESP_ERROR_CHECK(nvs_flash_init());
     ESP_ERROR_CHECK(esp_netif_init());
+#endif
     ESP_ERROR_CHECK(esp_event_loop_create_default());
 
     // Craete tasks
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""Local MQTT broker stand-in for the gateway host build.
+
+Accepts MQTT 3.1.1 clients over plain TCP, acknowledges CONNECT, QoS 1 PUBLISH
+and PINGREQ, discards the payloads and prints the publish rate. Enough to
+benchmark cloud_mqtt_task without AWS IoT Core or a full broker.
+
+Usage: tools/mqtt_broker_stub.py [--port 1883] [--verbose]
+"""
+
+import argparse
+import socket
+import threading
+import time
+
+CONNECT, CONNACK, PUBLISH, PUBACK, PINGREQ, PINGRESP, DISCONNECT = 1, 2, 3, 4, 12, 13, 14
+STATS_PERIOD_S = 5.0
+
+lock = threading.Lock()
+published = 0
+
+
+def recv_exact(conn, n):
+    buf = b""
+    while len(buf) < n:
+        chunk = conn.recv(n - len(buf))
+        if not chunk:
+            raise ConnectionError("client closed")
+        buf += chunk
+    return buf
+
+
+def read_packet(conn):
+    header = recv_exact(conn, 1)[0]
+    length, shift = 0, 0
+    while True:
+        byte = recv_exact(conn, 1)[0]
+        length |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            break
+    return header >> 4, header & 0x0F, recv_exact(conn, length)
+
+
+def serve(conn, addr, verbose):
+    global published
+    print(f"client {addr[0]}:{addr[1]} connected")
+    try:
+        while True:
+            ptype, flags, body = read_packet(conn)
+            if ptype == CONNECT:
+                conn.sendall(bytes([CONNACK << 4, 2, 0, 0]))
+            elif ptype == PUBLISH:
+                qos = (flags >> 1) & 0x03
+                topic_len = int.from_bytes(body[0:2], "big")
+                offset = 2 + topic_len
+                if qos > 0:
+                    conn.sendall(bytes([PUBACK << 4, 2]) + body[offset:offset + 2])
+                    offset += 2
+                if verbose:
+                    print(f"{body[2:2 + topic_len].decode()}: {body[offset:].decode(errors='replace')}")
+                with lock:
+                    published += 1
+            elif ptype == PINGREQ:
+                conn.sendall(bytes([PINGRESP << 4, 0]))
+            elif ptype == DISCONNECT:
+                break
+    except ConnectionError:
+        pass
+    finally:
+        conn.close()
+        print(f"client {addr[0]}:{addr[1]} disconnected")
+
+
+def report():
+    global published
+    while True:
+        time.sleep(STATS_PERIOD_S)
+        with lock:
+            count, published = published, 0
+        if count:
+            print(f"{count} publishes in {STATS_PERIOD_S:.0f} s ({count / STATS_PERIOD_S:.1f} msg/s)")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", type=int, default=1883)
+    parser.add_argument("--verbose", action="store_true", help="print every payload")
+    args = parser.parse_args()
+
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind(("127.0.0.1", args.port))
+    server.listen()
+    print(f"MQTT broker stand-in listening on 127.0.0.1:{args.port}")
+
+    threading.Thread(target=report, daemon=True).start()
+    while True:
+        conn, addr = server.accept()
+        threading.Thread(target=serve, args=(conn, addr, args.verbose), daemon=True).start()
+
+
+if __name__ == "__main__":
+    main()
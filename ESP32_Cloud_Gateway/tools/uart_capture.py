@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Record, inspect and synthesise .ucap UART captures for the gateway host build.
+
+The format is described in components/uart/host/uart_capture.h:
+  header : "UCAP" | u16 version | u16 reserved | u32 baud rate
+  record : u32 microseconds since previous record | u16 length | length bytes
+
+  uart_capture.py record /dev/ttyUSB0 stm32.ucap     # capture real STM32 traffic (Ctrl-C to stop)
+  uart_capture.py dump stm32.ucap                    # list records
+  uart_capture.py synth bench.ucap --frames 10000    # handshake + data frames, back to back
+
+Replay a capture by setting GATEWAY_HOST_UART_REPLAY_FILE in menuconfig.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import termios
+import time
+import tty
+
+HEADER = struct.Struct("<4sHHI")
+RECORD = struct.Struct("<IH")
+MAGIC, VERSION = b"UCAP", 1
+BAUD_CONSTANTS = {9600: termios.B9600, 57600: termios.B57600, 115200: termios.B115200}
+
+
+def write_header(out, baud):
+    out.write(HEADER.pack(MAGIC, VERSION, 0, baud))
+
+
+def write_record(out, delta_us, data):
+    out.write(RECORD.pack(delta_us, len(data)) + data)
+
+
+def read_capture(path):
+    with open(path, "rb") as f:
+        magic, version, _, baud = HEADER.unpack(f.read(HEADER.size))
+        if magic != MAGIC or version != VERSION:
+            sys.exit(f"{path}: not a v{VERSION} capture")
+        records = []
+        while raw := f.read(RECORD.size):
+            delta_us, length = RECORD.unpack(raw)
+            records.append((delta_us, f.read(length)))
+    return baud, records
+
+
+def record(args):
+    fd = os.open(args.device, os.O_RDONLY | os.O_NOCTTY)
+    tty.setraw(fd)
+    attrs = termios.tcgetattr(fd)
+    attrs[4] = attrs[5] = BAUD_CONSTANTS[args.baud]
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+
+    count = total = 0
+    with open(args.output, "wb") as out:
+        write_header(out, args.baud)
+        last = time.monotonic_ns()
+        try:
+            while chunk := os.read(fd, 120):
+                now = time.monotonic_ns()
+                write_record(out, (now - last) // 1000, chunk)
+                out.flush()
+                last = now
+                count, total = count + 1, total + len(chunk)
+        except KeyboardInterrupt:
+            pass
+    print(f"{count} records, {total} bytes")
+
+
+def dump(args):
+    baud, records = read_capture(args.capture)
+    print(f"baud {baud}, {len(records)} records, {sum(len(d) for _, d in records)} bytes")
+    for delta_us, data in records:
+        print(f"+{delta_us:>10} us {len(data):>5} B  {data!r}")
+
+
+def synth(args):
+    """STM32 traffic shape: READY? handshake then a data packet, per frame."""
+    with open(args.output, "wb") as out:
+        write_header(out, args.baud)
+        for _ in range(args.frames):
+            write_record(out, args.gap_us, b"READY?\n")
+            write_record(out, args.gap_us, args.payload.encode() + b"\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("record", help="capture a serial device")
+    p.add_argument("device")
+    p.add_argument("output")
+    p.add_argument("--baud", type=int, default=115200, choices=sorted(BAUD_CONSTANTS))
+    p.set_defaults(func=record)
+
+    p = sub.add_parser("dump", help="list the records of a capture")
+    p.add_argument("capture")
+    p.set_defaults(func=dump)
+
+    p = sub.add_parser("synth", help="write a synthetic capture")
+    p.add_argument("output")
+    p.add_argument("--frames", type=int, default=1000)
+    p.add_argument("--gap-us", type=int, default=0, help="recorded gap before each record")
+    p.add_argument("--payload", default="Message from STM32")
+    p.add_argument("--baud", type=int, default=115200)
+    p.set_defaults(func=synth)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
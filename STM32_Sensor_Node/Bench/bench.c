@@ -0,0 +1,195 @@
+/**
+ * @file bench.c
+ * @brief Timing, reporting and baseline comparison for the Bench/ programs.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench.h"
+
+#define BENCH_MAX_RESULTS       (128U)
+#define BENCH_NAME_LEN          (64U)
+
+typedef struct {
+    char   name[BENCH_NAME_LEN];
+    double ns_per_op;
+    double cycles_per_op;
+} BenchResult_t;
+
+static BenchResult_t results[BENCH_MAX_RESULTS];
+static uint32_t result_count;
+
+static const char *filter;
+static const char *save_path;
+static const char *baseline_path;
+static uint32_t tolerance_pct = BENCH_TOLERANCE_PCT;
+
+/**
+ * @brief Parse the common command line options and print the table header.
+ * @return 0 on success, -1 on an unknown option.
+*/
+int bench_init(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+            save_path = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance_pct = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--filter SUBSTR] [--save FILE] [--baseline FILE] [--tolerance PCT]\n",
+                    argv[0]);
+            return -1;
+        }
+    }
+    printf("%-44s %14s %12s %12s %14s\n", "benchmark", "ops", "ns/op", "cycles/op", "ops/s");
+    return 0;
+}
+
+uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/** @brief Cycle counter of the host CPU, or 0 where none is readable from user space */
+uint64_t bench_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    uint32_t lo, hi;
+    __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+#elif defined(__aarch64__)
+    uint64_t cnt;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(cnt));
+    return cnt;
+#else
+    return 0;
+#endif
+}
+
+/** @brief True if a case name matches --filter (always true without one) */
+int bench_selected(const char *name)
+{
+    return filter == NULL || strstr(name, filter) != NULL;
+}
+
+/**
+ * @brief Time one benchmark case.
+ * 
+ * Doubles the iteration count until a run lasts BENCH_MIN_RUN_NS, then keeps the
+ * fastest of BENCH_REPEATS runs. Skipped when it does not match --filter.
+*/
+void bench_run(const char *name, BenchFn_t fn, void *ctx)
+{
+    uint64_t iterations = 1;
+    uint64_t ns, cycles, best_ns = UINT64_MAX, best_cycles = 0;
+
+    if (!bench_selected(name)) {
+        return;
+    }
+
+    fn(ctx, iterations);                            // Warm up caches and branch predictors
+    for (;;) {
+        ns = bench_now_ns();
+        fn(ctx, iterations);
+        ns = bench_now_ns() - ns;
+        if (ns >= BENCH_MIN_RUN_NS) break;
+        iterations *= (ns < BENCH_MIN_RUN_NS / 16U) ? 16U : 2U;
+    }
+
+    for (uint32_t i = 0; i < BENCH_REPEATS; i++) {
+        cycles = bench_cycles();
+        ns     = bench_now_ns();
+        fn(ctx, iterations);
+        ns     = bench_now_ns() - ns;
+        cycles = bench_cycles() - cycles;
+        if (ns < best_ns) {
+            best_ns     = ns;
+            best_cycles = cycles;
+        }
+    }
+    bench_report(name, iterations, best_ns, best_cycles);
+}
+
+/** @brief Record and print one result; for cases timed by the caller */
+void bench_report(const char *name, uint64_t ops, uint64_t ns, uint64_t cycles)
+{
+    bench_report_ns(name, ops, ops ? (double)ns / (double)ops : 0.0,
+                    ops ? (double)cycles / (double)ops : 0.0);
+}
+
+/** @brief Record and print a per-op figure computed by the caller, e.g. a latency percentile */
+void bench_report_ns(const char *name, uint64_t ops, double ns_per_op, double cycles_per_op)
+{
+    printf("%-44s %14llu %12.2f %12.2f %14.0f\n", name, (unsigned long long)ops, ns_per_op, cycles_per_op,
+           ns_per_op > 0.0 ? 1e9 / ns_per_op : 0.0);
+    fflush(stdout);
+
+    if (result_count < BENCH_MAX_RESULTS) {
+        BenchResult_t *r = &results[result_count++];
+        snprintf(r->name, sizeof(r->name), "%s", name);
+        r->ns_per_op     = ns_per_op;
+        r->cycles_per_op = cycles_per_op;
+    }
+}
+
+/** @brief Find the result of a case by name, NULL if it was not run */
+static const BenchResult_t *find_result(const char *name)
+{
+    for (uint32_t i = 0; i < result_count; i++) {
+        if (strcmp(results[i].name, name) == 0) return &results[i];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Save results and compare them against the baseline, if requested.
+ * @return Process exit code: 1 if any case regressed beyond the tolerance or a file failed.
+*/
+int bench_finish(void)
+{
+    int status = 0;
+    char name[BENCH_NAME_LEN];
+    double ns_per_op, cycles_per_op;
+
+    if (save_path != NULL) {
+        FILE *f = fopen(save_path, "w");
+        if (f == NULL) {
+            perror(save_path);
+            return 1;
+        }
+        for (uint32_t i = 0; i < result_count; i++) {
+            fprintf(f, "%s %.3f %.3f\n", results[i].name, results[i].ns_per_op, results[i].cycles_per_op);
+        }
+        fclose(f);
+    }
+
+    if (baseline_path != NULL) {
+        FILE *f = fopen(baseline_path, "r");
+        if (f == NULL) {
+            perror(baseline_path);
+            return 1;
+        }
+        printf("\n%-44s %12s %12s %8s\n", "vs baseline", "base ns/op", "ns/op", "change");
+        while (fscanf(f, "%63s %lf %lf", name, &ns_per_op, &cycles_per_op) == 3) {
+            const BenchResult_t *r = find_result(name);
+            if (r == NULL || ns_per_op <= 0.0) continue;
+
+            double change = (r->ns_per_op - ns_per_op) * 100.0 / ns_per_op;
+            int regressed = change > (double)tolerance_pct;
+            printf("%-44s %12.2f %12.2f %+7.1f%%%s\n", name, ns_per_op, r->ns_per_op, change,
+                   regressed ? "  REGRESSION" : "");
+            status |= regressed;
+        }
+        fclose(f);
+    }
+    return status;
+}
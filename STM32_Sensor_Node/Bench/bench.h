@@ -0,0 +1,49 @@
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/**
+ * @file bench.h
+ * @brief Minimal host benchmark harness shared by the Bench/ programs.
+ * 
+ * A case is a function that performs `iterations` operations. bench_run() grows the
+ * iteration count until one run lasts BENCH_MIN_RUN_NS, repeats it BENCH_REPEATS times
+ * and reports the fastest run as ns/op and cycles/op. Results can be saved and later
+ * compared against, so a slowdown beyond the tolerance fails the run. Programs that
+ * time cases themselves check bench_selected() before running one.
+ * 
+ * Usage: <bench> [--filter SUBSTR] [--save FILE] [--baseline FILE] [--tolerance PCT]
+*/
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BENCH_MIN_RUN_NS        (20000000ULL)   // 20 ms per timed run
+#define BENCH_REPEATS           (5U)
+#define BENCH_TOLERANCE_PCT     (10U)           // Default allowed slowdown against a baseline
+
+/** @brief Keep a value alive without letting the compiler reason about it */
+#define BENCH_KEEP(x)           __asm__ volatile("" : : "r,m"(x) : "memory")
+
+/** @brief Force memory to be treated as read and written */
+#define BENCH_CLOBBER()         __asm__ volatile("" : : : "memory")
+
+typedef void (*BenchFn_t)(void *ctx, uint64_t iterations);
+
+// Function Prototypes
+int      bench_init(int argc, char **argv);
+void     bench_run(const char *name, BenchFn_t fn, void *ctx);
+int      bench_selected(const char *name);
+void     bench_report(const char *name, uint64_t ops, uint64_t ns, uint64_t cycles);
+void     bench_report_ns(const char *name, uint64_t ops, double ns_per_op, double cycles_per_op);
+int      bench_finish(void);
+uint64_t bench_now_ns(void);
+uint64_t bench_cycles(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_H_ */
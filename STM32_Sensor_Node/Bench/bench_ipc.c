@@ -0,0 +1,345 @@
+/**
+ * @file bench_ipc.c
+ * @brief FreeRTOS IPC benchmark on the POSIX port: queue vs stream buffer vs
+ *        message buffer vs direct-to-task notification.
+ *
+ * A producer task hands items to a lower-priority consumer task, as vTaskSensorRead
+ * does to vTaskController and vTaskController to vTaskTransmit. Items are the size of
+ * a pooled record pointer (what the pipeline passes), a whole SampleRecord_t (what it
+ * copied before the sample pool) and a log message, through channels of several depths:
+ *   - throughput : the producer sends back to back, blocking when the channel is full
+ *   - latency    : the producer sends one item and waits for the consumer to take it;
+ *                  each item carries its send time, so p50/p99 is the one-way handoff
+ * The notification channel is an SPSC ring of `depth` slots signalled with
+ * xTaskNotifyGive() / ulTaskNotifyTake(), since a notification carries only 32 bits.
+ *
+ * Build and run with `make bench-ipc`; absolute numbers reflect POSIX-port context
+ * switches, so compare the channels with each other rather than with the target.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "semphr.h"
+
+#include "bench.h"
+#include "shared_resources.h"
+
+#ifndef IPC_BENCH_ITEMS
+#define IPC_BENCH_ITEMS         (20000U)    // Items per throughput run
+#endif
+#ifndef IPC_LATENCY_ITEMS
+#define IPC_LATENCY_ITEMS       (2000U)     // Items per latency run
+#endif
+
+#define IPC_MAX_ITEM_SIZE       (LOG_MSG_MAX_LEN)
+#define IPC_MAX_DEPTH           (20U)
+
+#define IPC_DRIVER_PRIORITY     (tskIDLE_PRIORITY + 4U)
+#define IPC_PRODUCER_PRIORITY   (tskIDLE_PRIORITY + 3U)     // Producer above consumer, as in the pipeline
+#define IPC_CONSUMER_PRIORITY   (tskIDLE_PRIORITY + 2U)
+#define IPC_TASK_STACK          (configMINIMAL_STACK_SIZE * 4U)
+
+typedef enum {
+    IPC_QUEUE = 0,
+    IPC_STREAM_BUFFER,
+    IPC_MESSAGE_BUFFER,
+    IPC_NOTIFICATION,
+    IPC_KIND_COUNT
+} IpcKind_t;
+
+/** @brief One benchmark run: channel, item shape and the tasks on either side */
+typedef struct {
+    IpcKind_t             kind;
+    size_t                size;
+    uint32_t              depth;
+    uint32_t              items;
+    bool                  latency;
+
+    QueueHandle_t         queue;
+    StreamBufferHandle_t  stream;
+    MessageBufferHandle_t message;
+    uint8_t               ring[IPC_MAX_DEPTH][IPC_MAX_ITEM_SIZE];
+    volatile uint32_t     head;                 // Written by the producer only
+    volatile uint32_t     tail;                 // Written by the consumer only
+    volatile bool         producerWaiting;
+
+    TaskHandle_t          producer;
+    TaskHandle_t          consumer;
+    TaskHandle_t          driver;
+    SemaphoreHandle_t     startProducer;
+    SemaphoreHandle_t     startConsumer;
+    uint64_t              latencies[IPC_LATENCY_ITEMS];
+} IpcCase_t;
+
+static const char *const kind_names[IPC_KIND_COUNT] = {
+    "queue",
+    "stream_buffer",
+    "message_buffer",
+    "notification",
+};
+
+static const size_t item_sizes[] = { sizeof(SampleRecord_t *), sizeof(SampleRecord_t), LOG_MSG_MAX_LEN };
+static const uint32_t depths[]   = { 1U, 4U, IPC_MAX_DEPTH };
+
+static IpcCase_t ipc_case;
+static int bench_argc;
+static char **bench_argv;
+
+// Local function prototypes
+static bool ipc_send(IpcCase_t *c, const uint8_t *item);
+static bool ipc_receive(IpcCase_t *c, uint8_t *item);
+static void vTaskProducer(void *pvParameters);
+static void vTaskConsumer(void *pvParameters);
+static void run_case(IpcKind_t kind, size_t size, uint32_t depth, bool latency);
+static void vTaskBenchDriver(void *pvParameters);
+static int compare_u64(const void *a, const void *b);
+
+/** @brief Send one item, blocking while the channel is full */
+static bool ipc_send(IpcCase_t *c, const uint8_t *item)
+{
+    switch (c->kind) {
+    case IPC_QUEUE:
+        return xQueueSend(c->queue, item, portMAX_DELAY) == pdTRUE;
+    case IPC_STREAM_BUFFER:
+        return xStreamBufferSend(c->stream, item, c->size, portMAX_DELAY) == c->size;
+    case IPC_MESSAGE_BUFFER:
+        return xMessageBufferSend(c->message, item, c->size, portMAX_DELAY) == c->size;
+    case IPC_NOTIFICATION:
+        while (c->head - c->tail == c->depth) {
+            c->producerWaiting = true;
+            if (c->head - c->tail == c->depth) {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            }
+            c->producerWaiting = false;
+        }
+        memcpy(c->ring[c->head % c->depth], item, c->size);
+        c->head++;
+        xTaskNotifyGive(c->consumer);
+        return true;
+    default:
+        return false;
+    }
+}
+
+/** @brief Receive one item, blocking while the channel is empty */
+static bool ipc_receive(IpcCase_t *c, uint8_t *item)
+{
+    switch (c->kind) {
+    case IPC_QUEUE:
+        return xQueueReceive(c->queue, item, portMAX_DELAY) == pdTRUE;
+    case IPC_STREAM_BUFFER:
+        return xStreamBufferReceive(c->stream, item, c->size, portMAX_DELAY) == c->size;
+    case IPC_MESSAGE_BUFFER:
+        return xMessageBufferReceive(c->message, item, c->size, portMAX_DELAY) == c->size;
+    case IPC_NOTIFICATION:
+        while (c->head == c->tail) {
+            ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+        }
+        memcpy(item, c->ring[c->tail % c->depth], c->size);
+        c->tail++;
+        if (c->producerWaiting && !c->latency) {
+            xTaskNotifyGive(c->producer);
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Producer worker: for each case, sends c->items stamped items and, in latency
+ *        mode, waits for each to be taken.
+*/
+static void vTaskProducer(void *pvParameters)
+{
+    IpcCase_t *c = (IpcCase_t *)pvParameters;
+    uint8_t item[IPC_MAX_ITEM_SIZE] = {0U};
+    uint64_t now;
+    bool sent;
+
+    while (1) {
+        xSemaphoreTake(c->startProducer, portMAX_DELAY);
+        xTaskNotifyStateClear(NULL);
+        ulTaskNotifyValueClear(NULL, UINT32_MAX);
+
+        for (uint32_t i = 0; i < c->items; i++) {
+            now = bench_now_ns();
+            memcpy(item, &now, sizeof(now));
+            sent = ipc_send(c, item);
+            configASSERT(sent);
+            if (c->latency) {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Consumer worker: for each case, receives c->items items, records handoff
+ *        latency and notifies the driver when done.
+*/
+static void vTaskConsumer(void *pvParameters)
+{
+    IpcCase_t *c = (IpcCase_t *)pvParameters;
+    uint8_t item[IPC_MAX_ITEM_SIZE];
+    uint64_t sent;
+    bool received;
+
+    while (1) {
+        xSemaphoreTake(c->startConsumer, portMAX_DELAY);
+        xTaskNotifyStateClear(NULL);
+        ulTaskNotifyValueClear(NULL, UINT32_MAX);
+
+        for (uint32_t i = 0; i < c->items; i++) {
+            received = ipc_receive(c, item);
+            configASSERT(received);
+            if (c->latency) {
+                memcpy(&sent, item, sizeof(sent));
+                c->latencies[i] = bench_now_ns() - sent;
+                xTaskNotifyGive(c->producer);
+            }
+        }
+        xTaskNotifyGive(c->driver);
+    }
+}
+
+/** @brief Create the channel for one case, release the workers, time it and report */
+static void run_case(IpcKind_t kind, size_t size, uint32_t depth, bool latency)
+{
+    IpcCase_t *c = &ipc_case;
+    char name[64];
+    char p50[72];
+    char p99[72];
+    uint64_t ns, cycles;
+
+    snprintf(name, sizeof(name), "%s/%uB/depth%u/%s", kind_names[kind], (unsigned)size,
+             (unsigned)depth, latency ? "latency" : "throughput");
+    snprintf(p50, sizeof(p50), "%s_p50", name);
+    snprintf(p99, sizeof(p99), "%s_p99", name);
+    if (!bench_selected(name) && !(latency && (bench_selected(p50) || bench_selected(p99)))) {
+        return;                                 // Not matched by --filter
+    }
+
+    c->kind     = kind;
+    c->size     = size;
+    c->depth    = depth;
+    c->items    = latency ? IPC_LATENCY_ITEMS : IPC_BENCH_ITEMS;
+    c->latency  = latency;
+    c->head     = 0U;
+    c->tail     = 0U;
+    c->producerWaiting = false;
+    c->queue    = NULL;
+    c->stream   = NULL;
+    c->message  = NULL;
+
+    switch (kind) {
+    case IPC_QUEUE:
+        c->queue = xQueueCreate(depth, size);
+        configASSERT(c->queue != NULL);
+        break;
+    case IPC_STREAM_BUFFER:
+        c->stream = xStreamBufferCreate(depth * size, size);   // Trigger level: one whole item
+        configASSERT(c->stream != NULL);
+        break;
+    case IPC_MESSAGE_BUFFER:
+        c->message = xMessageBufferCreate(depth * (size + sizeof(size_t)));
+        configASSERT(c->message != NULL);
+        break;
+    default:
+        break;
+    }
+
+    // Both workers are below the driver, so neither runs until it blocks
+    xSemaphoreGive(c->startConsumer);
+    xSemaphoreGive(c->startProducer);
+
+    cycles = bench_cycles();
+    ns     = bench_now_ns();
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    ns     = bench_now_ns() - ns;
+    cycles = bench_cycles() - cycles;
+
+    if (latency) {
+        qsort(c->latencies, c->items, sizeof(c->latencies[0]), compare_u64);
+        bench_report_ns(p50, c->items, (double)c->latencies[c->items / 2U], 0.0);
+        bench_report_ns(p99, c->items, (double)c->latencies[(c->items * 99U) / 100U], 0.0);
+    } else {
+        bench_report(name, c->items, ns, cycles);
+    }
+
+    if (c->queue   != NULL) vQueueDelete(c->queue);
+    if (c->stream  != NULL) vStreamBufferDelete(c->stream);
+    if (c->message != NULL) vMessageBufferDelete(c->message);
+}
+
+/** @brief Runs every case in turn, then exits the process with the harness status */
+static void vTaskBenchDriver(void *pvParameters)
+{
+    (void)pvParameters;
+
+    IpcCase_t *c = &ipc_case;
+
+    if (bench_init(bench_argc, bench_argv) != 0) {
+        exit(2);
+    }
+
+    c->driver        = xTaskGetCurrentTaskHandle();
+    c->startProducer = xSemaphoreCreateBinary();
+    c->startConsumer = xSemaphoreCreateBinary();
+    configASSERT(c->startProducer != NULL && c->startConsumer != NULL);
+    xTaskCreate(vTaskConsumer, "Consumer", IPC_TASK_STACK, c, IPC_CONSUMER_PRIORITY, &c->consumer);
+    xTaskCreate(vTaskProducer, "Producer", IPC_TASK_STACK, c, IPC_PRODUCER_PRIORITY, &c->producer);
+
+    for (uint32_t mode = 0; mode < 2U; mode++) {
+        for (uint32_t k = 0; k < IPC_KIND_COUNT; k++) {
+            for (uint32_t s = 0; s < sizeof(item_sizes) / sizeof(item_sizes[0]); s++) {
+                for (uint32_t d = 0; d < sizeof(depths) / sizeof(depths[0]); d++) {
+                    run_case((IpcKind_t)k, item_sizes[s], depths[d], mode == 1U);
+                }
+            }
+        }
+    }
+
+    printf("\nFree heap: %u bytes (min ever %u)\n",
+           (unsigned int)xPortGetFreeHeapSize(), (unsigned int)xPortGetMinimumEverFreeHeapSize());
+    exit(bench_finish());
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv)
+{
+    bench_argc = argc;
+    bench_argv = argv;
+
+    xTaskCreate(vTaskBenchDriver, "Driver", IPC_TASK_STACK, NULL, IPC_DRIVER_PRIORITY, NULL);
+    vTaskStartScheduler();
+    return 1;
+}
+
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+{
+    (void)xTask;
+    fprintf(stderr, "Stack overflow in %s\n", pcTaskName);
+    abort();
+}
+
+void vAssertCalled(const char *pcFile, unsigned long ulLine)
+{
+    fprintf(stderr, "Assert failed: %s:%lu\n", pcFile, ulLine);
+    abort();
+}
@@ -0,0 +1,897 @@
+/**
+ * @file bench_object_model.cpp
+ * @brief Host microbenchmarks for the Room/Sensor/Device model and the C wrapper.
+ *
+ * Measures what one sample costs in the object model, without FreeRTOS:
+ *   - Sensor::readValue() through the vtable vs. a qualified (non-virtual) call
+ *   - the same sensor and room work on the CRTP model (static_model.h)
+ *   - rooms composed from only the parts they have (room_of.h)
+ *   - recording into a sample history and reducing a window of it in place
+ *   - copying a room's history out of a RoomRegistry under its seqlock, as samples
+ *     or as one aligned SampleBlock_t
+ *   - creating and destroying rooms from an ObjectPool vs. new/delete
+ *   - Sensor::setValue() and Room device toggles
+ *   - the extern "C" wrapper calls the tasks use, one by one and as a full sample
+ *   - the same work spread over many Room instances, to expose cache effects
+ *   - the same work on a struct-of-arrays RoomRegistry of up to ROOM_REGISTRY_MAX_ROOMS rooms
+ *
+ * Build and run with `make bench`; see bench.h for the command line options.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <new>
+
+#include "bench.h"
+#include "object_pool.h"
+#include "rooms.h"
+#include "room_of.h"
+#include "sample_history.h"
+#include "room_registry.h"
+#include "sensors.h"
+#include "static_model.h"
+#include "wrapper.h"
+
+#define SENSOR_SET_SIZE     (64U)           // Sensors per dispatch case, mixed types
+#define MANY_ROOM_MAX       (65536U)        // Largest Room population
+#define HISTORY_DEPTH       (64U)           // Samples kept by the history cases
+#define POOL_ROOMS          (16U)           // Rooms alive at once in the provisioning cases
+
+namespace {
+
+/** @brief A heap-allocated array of Room, numbered from 101 like the wrapper's room */
+struct RoomSet {
+    Room    *rooms;
+    uint32_t count;
+};
+
+RoomSet makeRooms(uint32_t count)
+{
+    RoomSet set;
+    set.rooms = static_cast<Room *>(::operator new(sizeof(Room) * count));
+    set.count = count;
+    for (uint32_t i = 0; i < count; i++) {
+        new (&set.rooms[i]) Room(static_cast<uint16_t>(101U + i));
+    }
+    return set;
+}
+
+void freeRooms(RoomSet &set)
+{
+    for (uint32_t i = 0; i < set.count; i++) {
+        set.rooms[i].~Room();
+    }
+    ::operator delete(set.rooms);
+}
+
+/** @brief Sensors of several rooms, alternating motion/temperature, read through Sensor* */
+struct SensorSet {
+    Sensor            *mixed[SENSOR_SET_SIZE];
+    TemperatureSensor *temp[SENSOR_SET_SIZE];
+};
+
+// ----- Sensor dispatch -----
+
+void benchReadVirtualMixed(void *ctx, uint64_t iterations)
+{
+    SensorSet *set = static_cast<SensorSet *>(ctx);
+    uint32_t sum = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        Sensor *s = set->mixed[i % SENSOR_SET_SIZE];
+        BENCH_KEEP(s);                          // Hide the dynamic type from the optimiser
+        sum += s->readValue();
+    }
+    BENCH_KEEP(sum);
+}
+
+void benchReadVirtualTemp(void *ctx, uint64_t iterations)
+{
+    SensorSet *set = static_cast<SensorSet *>(ctx);
+    uint32_t sum = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        Sensor *s = set->temp[i % SENSOR_SET_SIZE];
+        BENCH_KEEP(s);
+        sum += s->readValue();
+    }
+    BENCH_KEEP(sum);
+}
+
+void benchReadDirectTemp(void *ctx, uint64_t iterations)
+{
+    SensorSet *set = static_cast<SensorSet *>(ctx);
+    uint32_t sum = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        TemperatureSensor *s = set->temp[i % SENSOR_SET_SIZE];
+        BENCH_KEEP(s);
+        sum += s->TemperatureSensor::readValue();   // Qualified call: no vtable lookup
+    }
+    BENCH_KEEP(sum);
+}
+
+void benchSetValue(void *ctx, uint64_t iterations)
+{
+    SensorSet *set = static_cast<SensorSet *>(ctx);
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        Sensor *s = set->mixed[i % SENSOR_SET_SIZE];
+        BENCH_KEEP(s);
+        s->setValue(static_cast<uint16_t>(i));
+    }
+    BENCH_CLOBBER();
+}
+
+// ----- Static (CRTP) model -----
+
+/** @brief SENSOR_SET_SIZE rooms of the CRTP model, for the same sensor accesses as SensorSet */
+struct StaticRoomSet {
+    StaticRoom *rooms[SENSOR_SET_SIZE];
+};
+
+/** @brief As benchReadVirtualMixed: alternate motion/temperature, type known at compile time */
+void benchReadStaticMixed(void *ctx, uint64_t iterations)
+{
+    StaticRoomSet *set = static_cast<StaticRoomSet *>(ctx);
+    uint32_t sum = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        StaticRoom *room = set->rooms[i % SENSOR_SET_SIZE];
+        BENCH_KEEP(room);
+        sum += (i & 1U) ? room->getMotionDetector()->readValue()
+                        : room->getTemperatureSensor()->readValue();
+    }
+    BENCH_KEEP(sum);
+}
+
+void benchReadStaticTemp(void *ctx, uint64_t iterations)
+{
+    StaticRoomSet *set = static_cast<StaticRoomSet *>(ctx);
+    uint32_t sum = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        StaticTemperatureSensor *s = set->rooms[i % SENSOR_SET_SIZE]->getTemperatureSensor();
+        BENCH_KEEP(s);
+        sum += s->readValue();
+    }
+    BENCH_KEEP(sum);
+}
+
+void benchStaticSetValue(void *ctx, uint64_t iterations)
+{
+    StaticRoomSet *set = static_cast<StaticRoomSet *>(ctx);
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        StaticRoom *room = set->rooms[i % SENSOR_SET_SIZE];
+        BENCH_KEEP(room);
+        if (i & 1U) {
+            room->getMotionDetector()->setValue(static_cast<uint16_t>(i));
+        } else {
+            room->getTemperatureSensor()->setValue(static_cast<uint16_t>(i));
+        }
+    }
+    BENCH_CLOBBER();
+}
+
+void benchStaticRoomToggle(void *ctx, uint64_t iterations)
+{
+    StaticRoom *room = static_cast<StaticRoom *>(ctx);
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        BENCH_KEEP(room);
+        if (i & 1U) room->turnOnLight(); else room->turnOffLight();
+    }
+    BENCH_CLOBBER();
+}
+
+/** @brief As benchRoomControl, on a StaticRoom */
+void benchStaticRoomControl(void *ctx, uint64_t iterations)
+{
+    StaticRoom *room = static_cast<StaticRoom *>(ctx);
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        uint16_t temperature = static_cast<uint16_t>(15U + (i % 16U));
+        BENCH_KEEP(room);
+        if (temperature > 25U) {
+            room->turnOnAC();
+            room->turnOffHeater();
+        } else if (temperature < 20U) {
+            room->turnOnHeater();
+            room->turnOffAC();
+        } else {
+            room->turnOffAC();
+            room->turnOffHeater();
+        }
+        if (i & 1U) room->turnOnLight(); else room->turnOffLight();
+    }
+    BENCH_CLOBBER();
+}
+
+/** @brief As benchDirectSample, on a StaticRoom */
+void benchStaticSample(void *ctx, uint64_t iterations)
+{
+    StaticRoom *room = static_cast<StaticRoom *>(ctx);
+    uint32_t sum = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        BENCH_KEEP(room);
+        room->getTemperatureSensor()->setValue(static_cast<uint16_t>(15U + (i % 16U)));
+        room->getMotionDetector()->setValue(static_cast<uint16_t>(i & 1U));
+        room->setSampleTime(static_cast<uint32_t>(i));
+
+        uint16_t temperature = room->getTemperatureSensor()->readValue();
+        uint16_t motion      = room->getMotionDetector()->readValue();
+        sum += room->getSampleTime();
+
+        if (temperature > 25U) {
+            room->turnOnAC();
+            room->turnOffHeater();
+        } else if (temperature < 20U) {
+            room->turnOnHeater();
+            room->turnOffAC();
+        } else {
+            room->turnOffAC();
+            room->turnOffHeater();
+        }
+        if (motion > 0U) room->turnOnLight(); else room->turnOffLight();
+    }
+    BENCH_KEEP(sum);
+}
+
+// ----- Composed rooms -----
+
+typedef RoomOf<StaticMotionDetector, StaticTemperatureSensor,
+               StaticLight, StaticAC, StaticHeater>    FullRoom;
+typedef RoomOf<StaticMotionDetector, StaticLight>      StorageRoom;
+
+/** @brief As benchStaticSample, on a RoomOf with all five parts */
+void benchRoomOfFullSample(void *ctx, uint64_t iterations)
+{
+    FullRoom *room = static_cast<FullRoom *>(ctx);
+    uint32_t sum = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        BENCH_KEEP(room);
+        room->get<StaticTemperatureSensor>().setValue(static_cast<uint16_t>(15U + (i % 16U)));
+        room->get<StaticMotionDetector>().setValue(static_cast<uint16_t>(i & 1U));
+        room->setSampleTime(static_cast<uint32_t>(i));
+
+        uint16_t temperature = room->get<StaticTemperatureSensor>().readValue();
+        uint16_t motion      = room->get<StaticMotionDetector>().readValue();
+        sum += room->getSampleTime();
+
+        if (temperature > 25U) {
+            room->get<StaticAC>().turnOn();
+            room->get<StaticHeater>().turnOff();
+        } else if (temperature < 20U) {
+            room->get<StaticHeater>().turnOn();
+            room->get<StaticAC>().turnOff();
+        } else {
+            room->get<StaticAC>().turnOff();
+            room->get<StaticHeater>().turnOff();
+        }
+        if (motion > 0U) room->get<StaticLight>().turnOn(); else room->get<StaticLight>().turnOff();
+    }
+    BENCH_KEEP(sum);
+}
+
+/** @brief The same sample on a room with only motion and light: no temperature, AC or heater work */
+void benchRoomOfStorageSample(void *ctx, uint64_t iterations)
+{
+    StorageRoom *room = static_cast<StorageRoom *>(ctx);
+    uint32_t sum = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        BENCH_KEEP(room);
+        room->get<StaticMotionDetector>().setValue(static_cast<uint16_t>(i & 1U));
+        room->setSampleTime(static_cast<uint32_t>(i));
+
+        uint16_t motion = room->get<StaticMotionDetector>().readValue();
+        sum += room->getSampleTime();
+
+        if (motion > 0U) room->get<StaticLight>().turnOn(); else room->get<StaticLight>().turnOff();
+    }
+    BENCH_KEEP(sum);
+}
+
+/** @brief Sum every sensor of a FullRoom through tuple iteration */
+void benchRoomOfForEachSensor(void *ctx, uint64_t iterations)
+{
+    FullRoom *room = static_cast<FullRoom *>(ctx);
+    uint32_t sum = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        BENCH_KEEP(room);
+        room->forEachSensor([&sum](auto &sensor) { sum += sensor.readValue(); });
+    }
+    BENCH_KEEP(sum);
+}
+
+// ----- Sample history -----
+
+typedef SampleHistory<HISTORY_DEPTH> TemperatureHistory;
+
+void benchHistoryPush(void *ctx, uint64_t iterations)
+{
+    TemperatureHistory *history = static_cast<TemperatureHistory *>(ctx);
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        BENCH_KEEP(history);
+        history->push(static_cast<uint16_t>(i), static_cast<uint32_t>(i));
+    }
+    BENCH_CLOBBER();
+}
+
+/** @brief Mean of the last HISTORY_DEPTH / 2 values, read in place through a window (one op = one value) */
+void benchHistoryWindowMean(void *ctx, uint64_t iterations)
+{
+    TemperatureHistory *history = static_cast<TemperatureHistory *>(ctx);
+    uint32_t means = 0;
+
+    for (uint64_t done = 0; done < iterations; done += HISTORY_DEPTH / 2U) {
+        BENCH_KEEP(history);
+        SampleWindow<uint16_t> window = history->values(HISTORY_DEPTH / 2U);
+        uint32_t sum = 0;
+        window.forEach([&sum](uint16_t value) { sum += value; });
+        means += sum / window.size();
+    }
+    BENCH_KEEP(means);
+}
+
+/** @brief A room's whole history copied out of a registry under its seqlock (one op = one sample) */
+struct RegistryHistory {
+    RoomRegistry *registry;
+    RoomSample_t  samples[ROOM_HISTORY_SLOTS];
+    SampleBlock_t block;
+};
+
+void benchRegistryHistoryRead(void *ctx, uint64_t iterations)
+{
+    RegistryHistory *rh = static_cast<RegistryHistory *>(ctx);
+    uint32_t sum = 0;
+
+    for (uint64_t done = 0; done < iterations; done += ROOM_HISTORY_SLOTS) {
+        BENCH_KEEP(rh);
+        uint16_t count = rh->registry->readHistory(0U, ROOM_HISTORY_DEPTH, rh->samples, nullptr);
+        sum += count + rh->samples[0].temperature;
+    }
+    BENCH_KEEP(sum);
+}
+
+/** @brief The newest temperature samples of the same room as one aligned block (one op = one sample) */
+void benchRegistryBlockRead(void *ctx, uint64_t iterations)
+{
+    RegistryHistory *rh = static_cast<RegistryHistory *>(ctx);
+    uint32_t sum = 0;
+
+    for (uint64_t done = 0; done < iterations; done += SAMPLE_BLOCK_LEN) {
+        BENCH_KEEP(rh);
+        rh->registry->readBlock(0U, SENSOR_TEMPERATURE, 0U, &rh->block);
+        sum += rh->block.count + rh->block.values[0];
+    }
+    BENCH_KEEP(sum);
+}
+
+// ----- Runtime provisioning -----
+
+typedef ObjectPool<Room, POOL_ROOMS> RoomPool;
+
+/** @brief Replace one of POOL_ROOMS live rooms per op: destroy the oldest, create a new one */
+void benchPoolChurn(void *ctx, uint64_t iterations)
+{
+    RoomPool *pool = static_cast<RoomPool *>(ctx);
+    Room *live[POOL_ROOMS];
+
+    for (uint32_t i = 0; i < POOL_ROOMS; i++) {
+        live[i] = pool->create(static_cast<uint16_t>(101U + i));
+    }
+    for (uint64_t i = 0; i < iterations; i++) {
+        uint32_t slot = static_cast<uint32_t>(i % POOL_ROOMS);
+        pool->destroy(live[slot]);
+        live[slot] = pool->create(static_cast<uint16_t>(i));
+        BENCH_KEEP(live[slot]);
+    }
+    for (uint32_t i = 0; i < POOL_ROOMS; i++) {
+        pool->destroy(live[i]);
+    }
+}
+
+/** @brief The same churn through the general-purpose heap */
+void benchHeapChurn(void *ctx, uint64_t iterations)
+{
+    (void)ctx;
+    Room *live[POOL_ROOMS];
+
+    for (uint32_t i = 0; i < POOL_ROOMS; i++) {
+        live[i] = new Room(static_cast<uint16_t>(101U + i));
+    }
+    for (uint64_t i = 0; i < iterations; i++) {
+        uint32_t slot = static_cast<uint32_t>(i % POOL_ROOMS);
+        delete live[slot];
+        live[slot] = new Room(static_cast<uint16_t>(i));
+        BENCH_KEEP(live[slot]);
+    }
+    for (uint32_t i = 0; i < POOL_ROOMS; i++) {
+        delete live[i];
+    }
+}
+
+// ----- Room -----
+
+void benchRoomToggle(void *ctx, uint64_t iterations)
+{
+    Room *room = static_cast<Room *>(ctx);
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        BENCH_KEEP(room);
+        if (i & 1U) room->turnOnLight(); else room->turnOffLight();
+    }
+    BENCH_CLOBBER();
+}
+
+/** @brief One controller decision on a Room: three device updates, as control_devices() */
+void benchRoomControl(void *ctx, uint64_t iterations)
+{
+    Room *room = static_cast<Room *>(ctx);
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        uint16_t temperature = static_cast<uint16_t>(15U + (i % 16U));
+        BENCH_KEEP(room);
+        if (temperature > 25U) {
+            room->turnOnAC();
+            room->turnOffHeater();
+        } else if (temperature < 20U) {
+            room->turnOnHeater();
+            room->turnOffAC();
+        } else {
+            room->turnOffAC();
+            room->turnOffHeater();
+        }
+        if (i & 1U) room->turnOnLight(); else room->turnOffLight();
+    }
+    BENCH_CLOBBER();
+}
+
+// ----- C wrapper -----
+
+void benchWrapperSetTemperature(void *ctx, uint64_t iterations)
+{
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        setTemperature(static_cast<uint16_t>(i));
+    }
+}
+
+void benchWrapperGetTemperature(void *ctx, uint64_t iterations)
+{
+    (void)ctx;
+    uint32_t sum = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        sum += getTemperature();
+    }
+    BENCH_KEEP(sum);
+}
+
+void benchWrapperToggle(void *ctx, uint64_t iterations)
+{
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        if (i & 1U) turnOnLight(); else turnOffLight();
+    }
+}
+
+/** @brief What vTaskSensorRead used to do under the mutex: three getters */
+void benchWrapperReadGetters(void *ctx, uint64_t iterations)
+{
+    (void)ctx;
+    uint32_t sum = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        sum += getTemperature();
+        sum += getMotion();
+        sum += getSampleTime();
+    }
+    BENCH_KEEP(sum);
+}
+
+/** @brief The same read as one getSensorSnapshot() call */
+void benchWrapperReadSnapshot(void *ctx, uint64_t iterations)
+{
+    (void)ctx;
+    RoomSample_t sample;
+    uint32_t sum = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        getSensorSnapshot(&sample);
+        sum += sample.temperature + sample.motion + sample.sampleTime;
+    }
+    BENCH_KEEP(sum);
+}
+
+/** @brief What vTaskSensorWrite used to do under the mutex: three setters */
+void benchWrapperWriteSetters(void *ctx, uint64_t iterations)
+{
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        setTemperature(static_cast<uint16_t>(i));
+        setMotion(static_cast<uint16_t>(i & 1U));
+        setSampleTime(static_cast<uint32_t>(i));
+    }
+}
+
+/** @brief The same write as one setSensorSnapshot() call */
+void benchWrapperWriteSnapshot(void *ctx, uint64_t iterations)
+{
+    (void)ctx;
+    RoomSample_t sample;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        sample.temperature = static_cast<uint16_t>(i);
+        sample.motion      = static_cast<uint16_t>(i & 1U);
+        sample.sampleTime  = static_cast<uint32_t>(i);
+        setSensorSnapshot(&sample);
+    }
+}
+
+/**
+ * @brief Every wrapper call one sample goes through in the task pipeline:
+ *        write (3 setters), read (3 getters), control (3 device calls).
+*/
+void benchWrapperSample(void *ctx, uint64_t iterations)
+{
+    (void)ctx;
+    uint32_t sum = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        setTemperature(static_cast<uint16_t>(15U + (i % 16U)));
+        setMotion(static_cast<uint16_t>(i & 1U));
+        setSampleTime(static_cast<uint32_t>(i));
+
+        uint16_t temperature = getTemperature();
+        uint16_t motion      = getMotion();
+        sum += getSampleTime();
+
+        if (temperature > 25U) {
+            turnOnAC();
+            turnOffHeater();
+        } else if (temperature < 20U) {
+            turnOnHeater();
+            turnOffAC();
+        } else {
+            turnOffAC();
+            turnOffHeater();
+        }
+        if (motion > 0U) turnOnLight(); else turnOffLight();
+    }
+    BENCH_KEEP(sum);
+}
+
+/** @brief The same sample path as benchWrapperSample, on a Room directly */
+void benchDirectSample(void *ctx, uint64_t iterations)
+{
+    Room *room = static_cast<Room *>(ctx);
+    uint32_t sum = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        BENCH_KEEP(room);
+        room->getTemperatureSensor()->setValue(static_cast<uint16_t>(15U + (i % 16U)));
+        room->getMotionDetector()->setValue(static_cast<uint16_t>(i & 1U));
+        room->setSampleTime(static_cast<uint32_t>(i));
+
+        uint16_t temperature = room->getTemperatureSensor()->readValue();
+        uint16_t motion      = room->getMotionDetector()->readValue();
+        sum += room->getSampleTime();
+
+        if (temperature > 25U) {
+            room->turnOnAC();
+            room->turnOffHeater();
+        } else if (temperature < 20U) {
+            room->turnOnHeater();
+            room->turnOffAC();
+        } else {
+            room->turnOffAC();
+            room->turnOffHeater();
+        }
+        if (motion > 0U) room->turnOnLight(); else room->turnOffLight();
+    }
+    BENCH_KEEP(sum);
+}
+
+// ----- Many rooms -----
+
+/** @brief Write then read back the temperature of each room in turn (one op = one room) */
+void benchManyRoomsSample(void *ctx, uint64_t iterations)
+{
+    RoomSet *set = static_cast<RoomSet *>(ctx);
+    uint32_t sum = 0;
+    uint32_t r = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        Room &room = set->rooms[r];
+        room.getTemperatureSensor()->setValue(static_cast<uint16_t>(i));
+        sum += room.getTemperatureSensor()->readValue();
+        if (++r == set->count) r = 0;
+    }
+    BENCH_KEEP(sum);
+}
+
+/** @brief Controller decision for each room in turn (one op = one room) */
+void benchManyRoomsControl(void *ctx, uint64_t iterations)
+{
+    RoomSet *set = static_cast<RoomSet *>(ctx);
+    uint32_t r = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        Room &room = set->rooms[r];
+        uint16_t temperature = room.getTemperatureSensor()->readValue();
+        if (temperature > 25U) {
+            room.turnOnAC();
+            room.turnOffHeater();
+        } else {
+            room.turnOffAC();
+        }
+        if (room.getMotionDetector()->readValue() > 0U) room.turnOnLight(); else room.turnOffLight();
+        if (++r == set->count) r = 0;
+    }
+    BENCH_CLOBBER();
+}
+
+/** @brief Sum of every room's temperature through the Room objects (one op = one room) */
+void benchManyRoomsScan(void *ctx, uint64_t iterations)
+{
+    RoomSet *set = static_cast<RoomSet *>(ctx);
+    uint32_t sum = 0;
+    uint32_t r = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        sum += set->rooms[r].getTemperatureSensor()->readValue();
+        if (++r == set->count) r = 0;
+    }
+    BENCH_KEEP(sum);
+}
+
+// ----- Room registry -----
+
+/** @brief Room range snapshots, one op = one room */
+struct RegistryBatch {
+    RoomRegistry *registry;
+    RoomSample_t  samples[ROOM_REGISTRY_MAX_ROOMS];
+};
+
+void benchRegistrySnapshotBatch(void *ctx, uint64_t iterations)
+{
+    RegistryBatch *batch = static_cast<RegistryBatch *>(ctx);
+    uint16_t count = batch->registry->getRoomCount();
+
+    for (uint64_t done = 0; done < iterations; done += count) {
+        batch->registry->readSamples(0U, count, batch->samples);
+        BENCH_KEEP(batch->samples);
+    }
+    BENCH_CLOBBER();
+}
+
+void benchRegistryPerRoomGetters(void *ctx, uint64_t iterations)
+{
+    RegistryBatch *batch = static_cast<RegistryBatch *>(ctx);
+    uint16_t count = batch->registry->getRoomCount();
+    uint16_t r = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        batch->samples[r].temperature = batch->registry->getTemperature(r);
+        batch->samples[r].motion      = batch->registry->getMotion(r);
+        batch->samples[r].sampleTime  = batch->registry->getSampleTime(r);
+        if (++r == count) {
+            r = 0;
+            BENCH_KEEP(batch->samples);
+        }
+    }
+    BENCH_CLOBBER();
+}
+
+/** @brief Registry counterpart of benchManyRoomsSample */
+void benchRegistrySample(void *ctx, uint64_t iterations)
+{
+    RoomRegistry *registry = static_cast<RoomRegistry *>(ctx);
+    uint16_t count = registry->getRoomCount();
+    uint32_t sum = 0;
+    uint16_t r = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        registry->setTemperature(r, static_cast<uint16_t>(i));
+        sum += registry->getTemperature(r);
+        if (++r == count) r = 0;
+    }
+    BENCH_KEEP(sum);
+}
+
+/** @brief Registry counterpart of benchManyRoomsControl: whole passes of controlAll() */
+void benchRegistryControl(void *ctx, uint64_t iterations)
+{
+    RoomRegistry *registry = static_cast<RoomRegistry *>(ctx);
+    uint16_t count = registry->getRoomCount();
+
+    for (uint64_t done = 0; done < iterations; done += count) {
+        BENCH_KEEP(registry);
+        registry->controlAll(25U, 20U);
+    }
+    BENCH_CLOBBER();
+}
+
+/** @brief Device deltas: control every room with alternating thresholds, then take the changes */
+struct RegistryChanges {
+    RoomRegistry  *registry;
+    DeviceChange_t changes[DEVICE_KIND_COUNT * ROOM_REGISTRY_MAX_ROOMS];
+};
+
+void benchRegistryDeviceChanges(void *ctx, uint64_t iterations)
+{
+    RegistryChanges *batch = static_cast<RegistryChanges *>(ctx);
+    uint16_t count = batch->registry->getRoomCount();
+    uint32_t taken = 0;
+    uint64_t pass = 0;
+
+    for (uint64_t done = 0; done < iterations; done += count) {
+        BENCH_KEEP(batch);
+        if (pass++ & 1U) {
+            batch->registry->controlAll(25U, 20U);
+        } else {
+            batch->registry->controlAll(15U, 30U);
+        }
+        taken += batch->registry->takeDeviceChanges(batch->changes, DEVICE_KIND_COUNT * ROOM_REGISTRY_MAX_ROOMS);
+    }
+    BENCH_KEEP(taken);
+}
+
+/** @brief Registry counterpart of benchManyRoomsScan, over the temperature array */
+void benchRegistryScan(void *ctx, uint64_t iterations)
+{
+    RoomRegistry *registry = static_cast<RoomRegistry *>(ctx);
+    const uint16_t *temperatures = registry->temperatures();
+    uint16_t count = registry->getRoomCount();
+    uint32_t sum = 0;
+    uint16_t r = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        sum += temperatures[r];
+        if (++r == count) r = 0;
+    }
+    BENCH_KEEP(sum);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    char name[64];
+
+    if (bench_init(argc, argv) != 0) {
+        return 2;
+    }
+
+    RoomSet   dispatchRooms = makeRooms(SENSOR_SET_SIZE);
+    SensorSet sensors;
+    for (uint32_t i = 0; i < SENSOR_SET_SIZE; i++) {
+        Room &room = dispatchRooms.rooms[i];
+        sensors.mixed[i] = (i & 1U) ? static_cast<Sensor *>(room.getMotionDetector())
+                                    : static_cast<Sensor *>(room.getTemperatureSensor());
+        sensors.temp[i]  = room.getTemperatureSensor();
+    }
+
+    bench_run("sensor/readValue_virtual_mixed",   benchReadVirtualMixed, &sensors);
+    bench_run("sensor/readValue_virtual_temp",    benchReadVirtualTemp,  &sensors);
+    bench_run("sensor/readValue_direct_temp",     benchReadDirectTemp,   &sensors);
+    bench_run("sensor/setValue",                  benchSetValue,         &sensors);
+
+    FullRoom    fullRoom(201U);
+    StorageRoom storageRoom(202U);
+    bench_run("roomof/full_sample",               benchRoomOfFullSample,    &fullRoom);
+    bench_run("roomof/storage_sample",            benchRoomOfStorageSample, &storageRoom);
+    bench_run("roomof/forEachSensor",             benchRoomOfForEachSensor, &fullRoom);
+
+    TemperatureHistory *history = new TemperatureHistory();
+    for (uint32_t i = 0; i < HISTORY_DEPTH + 5U; i++) {
+        history->push(static_cast<uint16_t>(i), i);         // Full and wrapped
+    }
+    bench_run("history/push",                     benchHistoryPush,       history);
+    bench_run("history/window_mean",              benchHistoryWindowMean, history);
+    delete history;
+
+    RegistryHistory *registryHistory = new RegistryHistory();
+    registryHistory->registry = new RoomRegistry(ROOM_REGISTRY_EMPTY);
+    registryHistory->registry->addRoom(201U);
+    for (uint32_t i = 0; i < ROOM_HISTORY_DEPTH + SAMPLE_BLOCK_LEN; i++) {
+        registryHistory->registry->setTemperature(0U, static_cast<uint16_t>(i));
+    }
+    bench_run("history/registry_read",            benchRegistryHistoryRead, registryHistory);
+    bench_run("history/registry_block",           benchRegistryBlockRead,   registryHistory);
+    delete registryHistory->registry;
+    delete registryHistory;
+
+    RoomPool *roomPool = new RoomPool();
+    bench_run("pool/room_churn",                  benchPoolChurn,         roomPool);
+    bench_run("heap/room_churn",                  benchHeapChurn,         nullptr);
+    delete roomPool;
+
+    Room room(201U);
+    bench_run("room/toggle_light",                benchRoomToggle,       &room);
+    bench_run("room/control_decision",            benchRoomControl,      &room);
+    bench_run("room/sample_direct",               benchDirectSample,     &room);
+
+    StaticRoomSet staticRooms;
+    for (uint32_t i = 0; i < SENSOR_SET_SIZE; i++) {
+        staticRooms.rooms[i] = new StaticRoom(static_cast<uint16_t>(101U + i));
+    }
+    bench_run("static/readValue_mixed",           benchReadStaticMixed,  &staticRooms);
+    bench_run("static/readValue_temp",            benchReadStaticTemp,   &staticRooms);
+    bench_run("static/setValue",                  benchStaticSetValue,   &staticRooms);
+    for (uint32_t i = 0; i < SENSOR_SET_SIZE; i++) {
+        delete staticRooms.rooms[i];
+    }
+
+    StaticRoom staticRoom(201U);
+    bench_run("static/toggle_light",              benchStaticRoomToggle,  &staticRoom);
+    bench_run("static/control_decision",          benchStaticRoomControl, &staticRoom);
+    bench_run("static/sample_direct",             benchStaticSample,      &staticRoom);
+
+    bench_run("wrapper/setTemperature",           benchWrapperSetTemperature, nullptr);
+    bench_run("wrapper/getTemperature",           benchWrapperGetTemperature, nullptr);
+    bench_run("wrapper/toggle_light",             benchWrapperToggle,    nullptr);
+    bench_run("wrapper/sample",                   benchWrapperSample,    nullptr);
+    bench_run("wrapper/read_getters",             benchWrapperReadGetters,   nullptr);
+    bench_run("wrapper/read_snapshot",            benchWrapperReadSnapshot,  nullptr);
+    bench_run("wrapper/write_setters",            benchWrapperWriteSetters,  nullptr);
+    bench_run("wrapper/write_snapshot",           benchWrapperWriteSnapshot, nullptr);
+
+    for (uint32_t count = 1U; count <= MANY_ROOM_MAX; count *= 16U) {
+        RoomSet set = makeRooms(count);
+        snprintf(name, sizeof(name), "rooms_%u/sample", (unsigned)count);
+        bench_run(name, benchManyRoomsSample, &set);
+        snprintf(name, sizeof(name), "rooms_%u/control", (unsigned)count);
+        bench_run(name, benchManyRoomsControl, &set);
+        snprintf(name, sizeof(name), "rooms_%u/scan_temperature", (unsigned)count);
+        bench_run(name, benchManyRoomsScan, &set);
+        freeRooms(set);
+
+        if (count <= ROOM_REGISTRY_MAX_ROOMS) {
+            RoomRegistry *registry = new RoomRegistry(ROOM_REGISTRY_EMPTY);
+            for (uint32_t i = 0; i < count; i++) {
+                registry->addRoom(static_cast<uint16_t>(101U + i));
+            }
+            snprintf(name, sizeof(name), "registry_%u/sample", (unsigned)count);
+            bench_run(name, benchRegistrySample, registry);
+            snprintf(name, sizeof(name), "registry_%u/control", (unsigned)count);
+            bench_run(name, benchRegistryControl, registry);
+            snprintf(name, sizeof(name), "registry_%u/scan_temperature", (unsigned)count);
+            bench_run(name, benchRegistryScan, registry);
+
+            RegistryBatch *batch = new RegistryBatch();
+            batch->registry = registry;
+            snprintf(name, sizeof(name), "registry_%u/read_getters", (unsigned)count);
+            bench_run(name, benchRegistryPerRoomGetters, batch);
+            snprintf(name, sizeof(name), "registry_%u/read_snapshots", (unsigned)count);
+            bench_run(name, benchRegistrySnapshotBatch, batch);
+            delete batch;
+
+            RegistryChanges *changes = new RegistryChanges();
+            changes->registry = registry;
+            snprintf(name, sizeof(name), "registry_%u/control_changes", (unsigned)count);
+            bench_run(name, benchRegistryDeviceChanges, changes);
+            delete changes;
+            delete registry;
+        }
+    }
+    freeRooms(dispatchRooms);
+
+    printf("\nsizeof(Room) = %u, sizeof(Sensor) = %u, sizeof(Device) = %u\n",
+           (unsigned)sizeof(Room), (unsigned)sizeof(Sensor), (unsigned)sizeof(Device));
+    printf("sizeof(StaticRoom) = %u, sizeof(StaticTemperatureSensor) = %u, sizeof(StaticLight) = %u\n",
+           (unsigned)sizeof(StaticRoom), (unsigned)sizeof(StaticTemperatureSensor), (unsigned)sizeof(StaticLight));
+    printf("sizeof(RoomOf<5 parts>) = %u, sizeof(RoomOf<Motion, Light>) = %u\n",
+           (unsigned)sizeof(FullRoom), (unsigned)sizeof(StorageRoom));
+    printf("sizeof(RoomRegistry) = %u (%u rooms, %u bytes per room)\n",
+           (unsigned)sizeof(RoomRegistry), (unsigned)ROOM_REGISTRY_MAX_ROOMS,
+           (unsigned)(sizeof(RoomRegistry) / ROOM_REGISTRY_MAX_ROOMS));
+    return bench_finish();
+}
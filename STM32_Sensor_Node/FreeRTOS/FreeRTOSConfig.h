@@ -70,9 +70,16 @@
 #define configUSE_IDLE_HOOK                 0
 #define configUSE_TICK_HOOK                 0
 #define configCPU_CLOCK_HZ                  ( ( unsigned long ) 16000000 )
-#define configTICK_RATE_HZ                  ( ( portTickType ) 1000 )
+#ifndef configTICK_RATE_HZ
+#define configTICK_RATE_HZ                  ( ( portTickType ) 1000 )     /* Raise (e.g. -DconfigTICK_RATE_HZ=10000) for sample rates above 1 kHz */
+#endif
 #define configMINIMAL_STACK_SIZE            ( ( unsigned short ) 512 )
+#if defined( HOST_BUILD )
+/* Host stacks are made of 64-bit words, so the same stack depths need twice the heap. */
+#define configTOTAL_HEAP_SIZE               ( ( size_t ) ( 40960 * 2 ) )
+#else
 #define configTOTAL_HEAP_SIZE               ( ( size_t ) ( 40960 ) )
+#endif
 #define configMAX_TASK_NAME_LEN             ( 12 )
 #define configUSE_TRACE_FACILITY            1
 #define configUSE_16_BIT_TICKS              0
@@ -98,6 +105,22 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelay                  1
 #define INCLUDE_uxTaskGetStackHighWaterMark 1
 
+#if defined( HOST_BUILD )
+/* Host (FreeRTOS POSIX port) build: there are no interrupt priorities or exception
+ * handlers to map, and a failed assertion should abort the process. */
+extern void vAssertCalled( const char *pcFile, unsigned long ulLine );
+#define configASSERT(x)    if((x) == 0) { vAssertCalled( __FILE__, __LINE__ ); }
+
+#if defined( SIM_VIRTUAL_TIME )
+/* Virtual-time simulation (`make sim`): whenever every task is blocked, the idle task
+ * advances the tick count straight to the next wake-up instead of waiting for it.
+ * See Src/host/sim_time.c. */
+#define configUSE_TICKLESS_IDLE                 2
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   2
+extern void vSimSuppressTicksAndSleep( unsigned long xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( x )       vSimSuppressTicksAndSleep( x )
+#endif /* SIM_VIRTUAL_TIME */
+#else
 /* Be ENORMOUSLY careful if you want to modify these two values and make sure
  * you read http://www.freertos.org/a00110.html#kernel_priority first!
 */
@@ -109,4 +132,6 @@ to exclude the API function. */
 #define vPortSVCHandler        SVC_Handler
 #define xPortPendSVHandler     PendSV_Handler
 #define xPortSysTickHandler    SysTick_Handler
+#endif /* HOST_BUILD */
+
 #endif /* FREERTOS_CONFIG_H */
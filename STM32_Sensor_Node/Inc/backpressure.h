@@ -0,0 +1,49 @@
+#ifndef BACKPRESSURE_H_
+#define BACKPRESSURE_H_
+
+/**
+ * @file backpressure.h
+ * @brief Adaptive sample-rate backpressure for the sensor pipeline.
+ *
+ * vTaskSensorWrite passes each sample delay through backpressure_scale_delay(),
+ * which looks at the fullest of xSensorQueue, xStreamBuffer and the sample pool.
+ * At or above BACKPRESSURE_HIGH_PCT the sample period doubles, up to
+ * 2^BACKPRESSURE_MAX_LEVEL times the configured one; at or below
+ * BACKPRESSURE_LOW_PCT it halves again. Between the two thresholds the rate is
+ * kept, so it does not oscillate. Under sustained load the pipeline samples less
+ * often instead of dropping samples downstream. xLogQueue is not considered:
+ * log lines are expendable.
+*/
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+/** @brief Fill level (percent) at which the sample period is doubled */
+#ifndef BACKPRESSURE_HIGH_PCT
+#define BACKPRESSURE_HIGH_PCT       (75U)
+#endif
+
+/** @brief Fill level (percent) at which a doubling is undone */
+#ifndef BACKPRESSURE_LOW_PCT
+#define BACKPRESSURE_LOW_PCT        (25U)
+#endif
+
+/** @brief Most doublings of the sample period (0 disables backpressure) */
+#ifndef BACKPRESSURE_MAX_LEVEL
+#define BACKPRESSURE_MAX_LEVEL      (3U)
+#endif
+
+/** @brief Backpressure state and counters */
+typedef struct {
+    uint32_t level;         /**< Current doublings of the sample period */
+    uint32_t maxLevel;      /**< Highest level reached */
+    uint32_t throttles;     /**< Times the period was doubled */
+    uint32_t fillPct;       /**< Fill level of the fullest resource at the last sample */
+} BackpressureStats_t;
+
+// Function Prototypes
+TickType_t backpressure_scale_delay(TickType_t xDelay);
+void       backpressure_get(BackpressureStats_t *stats);
+
+#endif /* BACKPRESSURE_H_ */
@@ -0,0 +1,22 @@
+#ifndef CHANGE_OBSERVER_H_
+#define CHANGE_OBSERVER_H_
+
+/**
+ * @file change_observer.h
+ * @brief Callback for sensor values that moved past their deadband.
+ * 
+ * Plain C type shared by the C wrapper and the C++ RoomRegistry.
+ * The observer runs in the context of the task that set the value, so it
+ * must be short: typically a direct-to-task notification of the consumer.
+*/
+
+#include <stdint.h>
+
+/**
+ * @brief Called when a value differs from the last reported one by more than the deadband.
+ * @param id       Room slot in the RoomRegistry.
+ * @param context  Pointer given when the observer was installed.
+*/
+typedef void (*ChangeObserver_t)(uint16_t id, void *context);
+
+#endif /* CHANGE_OBSERVER_H_ */
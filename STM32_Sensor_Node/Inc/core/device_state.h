@@ -0,0 +1,28 @@
+#ifndef DEVICE_STATE_H_
+#define DEVICE_STATE_H_
+
+/**
+ * @file device_state.h
+ * @brief Device kinds and state-change records of the packed device bitmap.
+ *
+ * Plain C types shared by the C wrapper and the C++ RoomRegistry.
+*/
+
+#include <stdint.h>
+
+/** @brief Device kinds, one bit per room in each */
+typedef enum {
+    DEVICE_LIGHT = 0,
+    DEVICE_AC,
+    DEVICE_HEATER,
+    DEVICE_KIND_COUNT
+} DeviceKind_t;
+
+/** @brief One device whose state changed since the last publish */
+typedef struct {
+    uint16_t roomIndex;     /**< Registry slot of the room */
+    uint8_t  kind;          /**< DeviceKind_t */
+    uint8_t  on;            /**< Current state (1 = on) */
+} DeviceChange_t;
+
+#endif /* DEVICE_STATE_H_ */
@@ -0,0 +1,120 @@
+#ifndef OBJECT_POOL_H_
+#define OBJECT_POOL_H_
+
+/**
+ * @file object_pool.h
+ * @brief Fixed-capacity pool for runtime creation of Room, Sensor and Device objects.
+ *
+ * ObjectPool<T, N> holds raw, suitably aligned storage for N objects of type T
+ * and constructs them in place (placement new), so rooms can be provisioned and
+ * removed at runtime without the FreeRTOS heap or newlib malloc. create() and
+ * destroy() are O(1): free slots form a singly linked list of slot indices, and
+ * slots never used yet are taken from a high-water mark.
+ *
+ * Every member starts at zero, so a static pool is placed in .bss and needs no
+ * constructor at boot:
+ *
+ *     static ObjectPool<Room, 8U> roomPool;
+ *     Room* room = roomPool.create(102U);      // nullptr when the pool is full
+ *     roomPool.destroy(room);
+ *
+ * Sensor and Device are abstract, so pools are per concrete type
+ * (ObjectPool<TemperatureSensor, N>, ObjectPool<Light, N>, ...).
+ * Not thread-safe: one task owns a pool, or callers serialize access.
+ *
+ * The firmware does not use it: rooms behind the C wrapper are slots of
+ * RoomRegistry, and addRoom() provisions them without creating objects. The pool
+ * is for code built on the Room/Sensor/Device classes (currently Bench/), which
+ * needs whole objects of mixed concrete types that are also destroyed again,
+ * something the append-only registry slots do not offer.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <new>
+#include <utility>
+
+template <class T, uint16_t Capacity>
+class ObjectPool {
+    static_assert(Capacity > 0U && Capacity < 0xFFFFU, "ObjectPool capacity must be 1..65534");
+
+    static constexpr uint16_t SLOT_LIVE = 0xFFFFU;      // nextFree[] mark of a constructed slot
+
+private:
+    alignas(T) unsigned char storage[Capacity][sizeof(T)];   // Raw slots, constructed on create()
+    uint16_t nextFree[Capacity];                // Free list link of each free slot, as index + 1 (0 = end), or SLOT_LIVE
+    uint16_t freeHead;                          // First free slot + 1, or 0 if the list is empty
+    uint16_t highWater;                         // Slots ever handed out; slots above it are unused
+    uint16_t live;                              // Objects currently constructed
+
+public:
+    constexpr ObjectPool()
+        : storage{}, nextFree{}, freeHead(0U), highWater(0U), live(0U) {}
+
+    ~ObjectPool() = default;                    // Objects still live are not destroyed
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /**
+     * @brief Construct a T in a free slot with the given constructor arguments.
+     * @return The new object, or nullptr if every slot is in use.
+    */
+    template <class... Args>
+    T* create(Args&&... args) {
+        uint16_t index;
+        if (freeHead != 0U) {
+            index = static_cast<uint16_t>(freeHead - 1U);
+            freeHead = nextFree[index];
+        } else if (highWater < Capacity) {
+            index = highWater++;
+        } else {
+            return nullptr;
+        }
+        nextFree[index] = SLOT_LIVE;
+        live++;
+        return new (storage[index]) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroy an object created by this pool and free its slot.
+     * @return false (and nothing done) if obj is nullptr, not a slot of this pool
+     *         or already destroyed.
+    */
+    bool destroy(T* obj) {
+        if (!owns(obj)) {
+            return false;
+        }
+        uint16_t index = static_cast<uint16_t>((reinterpret_cast<unsigned char*>(obj) - storage[0]) / sizeof(T));
+        if (nextFree[index] != SLOT_LIVE) {
+            return false;
+        }
+        obj->~T();
+        nextFree[index] = freeHead;
+        freeHead = static_cast<uint16_t>(index + 1U);
+        live--;
+        return true;
+    }
+
+    // True if p points at the start of a slot of this pool (live or not)
+    bool owns(const T* p) const {
+        const unsigned char* byte = reinterpret_cast<const unsigned char*>(p);
+        if (p == nullptr || byte < storage[0] || byte >= storage[0] + sizeof(storage)) {
+            return false;
+        }
+        return ((byte - storage[0]) % sizeof(T)) == 0U;
+    }
+
+    static constexpr uint16_t capacity() {
+        return Capacity;
+    }
+
+    uint16_t inUse() const {
+        return live;
+    }
+
+    uint16_t available() const {
+        return static_cast<uint16_t>(Capacity - live);
+    }
+};
+
+#endif /* OBJECT_POOL_H_ */
@@ -0,0 +1,157 @@
+#ifndef ROOM_OF_H_
+#define ROOM_OF_H_
+
+/**
+ * @file room_of.h
+ * @brief Room composed at compile time from only the sensors and devices it has.
+ *
+ * RoomOf<Parts...> holds one object of each listed type, in a std::tuple, and
+ * nothing else: a storage room declared as
+ *
+ *     typedef RoomOf<StaticMotionDetector, StaticLight> StorageRoom;
+ *
+ * carries no AC or Heater objects and no code that touches them. Parts are the
+ * CRTP sensors and devices of static_model.h (or any type derived from
+ * StaticSensor / StaticDevice), each constructed with the room number.
+ *
+ * Access is resolved at compile time: get<I>() by position, get<T>() by type
+ * (each type at most once), has<T>() to test for a part. forEach() calls a
+ * function on every part in order, forEachSensor() / forEachDevice() on one
+ * kind only; with a generic lambda each call is inlined for its part type.
+ *
+ * Header-only; uses C++14 (index sequences, generic lambdas).
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "static_model.h"
+
+/** @brief True if T is a compile-time dispatched sensor / device */
+template <class T>
+struct IsStaticSensor : std::is_base_of<StaticSensor<T>, T> {};
+
+template <class T>
+struct IsStaticDevice : std::is_base_of<StaticDevice<T>, T> {};
+
+/** @brief Position of T in Parts..., or sizeof...(Parts) if absent */
+template <class T, class... Parts>
+struct PartIndex;
+
+template <class T>
+struct PartIndex<T> : std::integral_constant<size_t, 0U> {};
+
+template <class T, class... Rest>
+struct PartIndex<T, T, Rest...> : std::integral_constant<size_t, 0U> {};
+
+template <class T, class First, class... Rest>
+struct PartIndex<T, First, Rest...>
+    : std::integral_constant<size_t, 1U + PartIndex<T, Rest...>::value> {};
+
+template <class... Parts>
+class RoomOf {
+    static_assert(sizeof...(Parts) > 0U, "A room needs at least one sensor or device");
+
+private:
+    uint16_t roomNumber;                      // Unique ID for the room
+    uint32_t sampleTime;                      // Creation time of the latest sensor sample
+    std::tuple<Parts...> parts;               // One object per sensor / device type
+
+    template <class F, size_t... I>
+    void forEachPart(F& f, std::index_sequence<I...>) {
+        int expand[] = { 0, (f(std::get<I>(parts)), 0)... };
+        (void)expand;
+    }
+
+    template <class F, size_t... I>
+    void forEachPart(F& f, std::index_sequence<I...>) const {
+        int expand[] = { 0, (f(std::get<I>(parts)), 0)... };
+        (void)expand;
+    }
+
+    // Call f(part) only when Match holds for the part's type
+    template <class F, class T>
+    static void callIf(std::true_type, F& f, T& part) { f(part); }
+
+    template <class F, class T>
+    static void callIf(std::false_type, F&, T&) {}
+
+public:
+    static constexpr size_t partCount = sizeof...(Parts);
+
+    explicit RoomOf(uint16_t roomNumber)
+        : roomNumber(roomNumber),
+          sampleTime(0U),
+          parts(Parts(roomNumber)...) {}
+
+    uint16_t getRoomNumber() const { return roomNumber; }
+
+    // Part by position
+    template <size_t I>
+    typename std::tuple_element<I, std::tuple<Parts...>>::type& get() {
+        return std::get<I>(parts);
+    }
+
+    template <size_t I>
+    const typename std::tuple_element<I, std::tuple<Parts...>>::type& get() const {
+        return std::get<I>(parts);
+    }
+
+    // Part by type
+    template <class T>
+    static constexpr bool has() {
+        return PartIndex<T, Parts...>::value < sizeof...(Parts);
+    }
+
+    template <class T>
+    T& get() {
+        static_assert(has<T>(), "Room has no part of this type");
+        return std::get<PartIndex<T, Parts...>::value>(parts);
+    }
+
+    template <class T>
+    const T& get() const {
+        static_assert(has<T>(), "Room has no part of this type");
+        return std::get<PartIndex<T, Parts...>::value>(parts);
+    }
+
+    // Call f(part) for every part, in declaration order
+    template <class F>
+    void forEach(F f) {
+        forEachPart(f, std::index_sequence_for<Parts...>());
+    }
+
+    template <class F>
+    void forEach(F f) const {
+        forEachPart(f, std::index_sequence_for<Parts...>());
+    }
+
+    // Call f(sensor) / f(device) for the parts of one kind only
+    template <class F>
+    void forEachSensor(F f) {
+        forEach([&f](auto& part) {
+            callIf(IsStaticSensor<typename std::decay<decltype(part)>::type>(), f, part);
+        });
+    }
+
+    template <class F>
+    void forEachDevice(F f) {
+        forEach([&f](auto& part) {
+            callIf(IsStaticDevice<typename std::decay<decltype(part)>::type>(), f, part);
+        });
+    }
+
+    // Switch every device of the room
+    void allDevicesOff() {
+        forEachDevice([](auto& device) { device.turnOff(); });
+    }
+
+    // Creation time of the latest sensor sample, for latency tracking
+    void setSampleTime(uint32_t timestamp) { sampleTime = timestamp; }
+    uint32_t getSampleTime() const         { return sampleTime; }
+};
+
+#endif /* ROOM_OF_H_ */
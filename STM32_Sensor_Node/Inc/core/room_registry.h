@@ -0,0 +1,210 @@
+#ifndef ROOM_REGISTRY_H_
+#define ROOM_REGISTRY_H_
+
+/**
+ * @file room_registry.h
+ * @brief Registry of many rooms with struct-of-arrays storage.
+ *
+ * Each field (temperature, motion, sample time, light/AC/heater state) is one
+ * contiguous array indexed by room slot, instead of being spread over one Room
+ * object per room. A pass over one field across every room, such as the
+ * controller's temperature scan, then reads consecutive memory.
+ *
+ * Rooms are addressed by slot index. By default a registry starts with the rooms
+ * of the building topology (topology.h) in slots 0..BUILDING_ROOM_COUNT-1, their
+ * numbers read from the flash table; addRoom() appends after them. Every member
+ * of such a registry starts at zero, so a static one is placed in .bss and needs
+ * no constructor at boot. RoomRegistry(ROOM_REGISTRY_EMPTY) starts with no rooms.
+ *
+ * Sensor values are published with a seqlock per slot, so one writer task and
+ * any number of reader tasks share a room without a mutex. readSamples() never
+ * blocks: it retries the copy if the writer updated the slot meanwhile. The
+ * writer must not be preempted by a spinning reader, i.e. it runs at a higher
+ * priority than the readers (SensorWrite 5 over SensorRead 4).
+ * Device states are packed one bit per room for each DeviceKind_t. Setting or
+ * clearing a bit is atomic, and a bit that changes value is also set in a dirty
+ * mask, so takeDeviceChanges() can report only what changed since the last call.
+ *
+ * Each write also records the room's resulting sample in a ring of the last
+ * ROOM_HISTORY_DEPTH samples (room_sample.h), under the same seqlock, so
+ * readHistory() returns a window of recent samples that no write has torn, and
+ * readBlock() one sensor's new samples as an aligned SampleBlock_t.
+ *
+ * An optional observer is called by the writer when a room's temperature or
+ * motion moves past its deadband from the value last reported for that room,
+ * so a consumer can wait for changes instead of polling.
+ *
+ * Room management is not thread-safe and stays with one task.
+*/
+
+#include <stdint.h>
+#include "room_sample.h"
+#include "sample_block.h"
+#include "device_state.h"
+#include "topology.h"
+#include "change_observer.h"
+
+/** @brief Slots beyond the building topology left for addRoom() */
+#ifndef ROOM_REGISTRY_HEADROOM
+#define ROOM_REGISTRY_HEADROOM      (7U)
+#endif
+
+/** @brief Capacity of a registry; every array is sized by it, so keep it near the topology */
+#ifndef ROOM_REGISTRY_MAX_ROOMS
+#define ROOM_REGISTRY_MAX_ROOMS     (BUILDING_ROOM_COUNT + ROOM_REGISTRY_HEADROOM)
+#endif
+
+#define ROOM_INDEX_INVALID          (0xFFFFU)   // Returned when a room cannot be added or found
+
+/** @brief Selects a registry without the building topology */
+enum RoomRegistryEmpty_t { ROOM_REGISTRY_EMPTY };
+
+#define DEVICE_BITMAP_WORDS         ((ROOM_REGISTRY_MAX_ROOMS + 31U) / 32U)     // 32 rooms per word
+
+class RoomRegistry {
+    friend class RoomRegistryTest;                      // Host tests (Test/) step the seqlock writer side
+
+private:
+    uint16_t addedCount;                                // Rooms added by addRoom(), after the topology rooms
+    bool     noTopology;                                // Built empty; false (zero) keeps a static registry in .bss
+
+    // One array per field, indexed by slot
+    uint16_t roomNumbers[ROOM_REGISTRY_MAX_ROOMS];      // Room ID of each slot added by addRoom()
+    uint16_t temperature[ROOM_REGISTRY_MAX_ROOMS];      // Temperature sensor values
+    uint16_t motion[ROOM_REGISTRY_MAX_ROOMS];           // Motion detector values
+    uint32_t sampleTime[ROOM_REGISTRY_MAX_ROOMS];       // Creation time of the latest sample
+    uint32_t sequence[ROOM_REGISTRY_MAX_ROOMS];         // Seqlock of the sensor fields, odd while being written
+
+    // Sample history rings, ROOM_HISTORY_DEPTH entries per slot, under the slot's seqlock
+    uint16_t historyTemperature[ROOM_REGISTRY_MAX_ROOMS][ROOM_HISTORY_SLOTS];
+    uint16_t historyMotion[ROOM_REGISTRY_MAX_ROOMS][ROOM_HISTORY_SLOTS];
+    uint32_t historyTime[ROOM_REGISTRY_MAX_ROOMS][ROOM_HISTORY_SLOTS];
+    uint32_t historyCount[ROOM_REGISTRY_MAX_ROOMS];     // Samples ever recorded; the next entry is historyCount % depth
+
+    // Device states, bit (slot % 32) of word (slot / 32), one bitmap per DeviceKind_t
+    uint32_t deviceState[DEVICE_KIND_COUNT][DEVICE_BITMAP_WORDS];     // 1 = on
+    uint32_t deviceDirty[DEVICE_KIND_COUNT][DEVICE_BITMAP_WORDS];     // 1 = changed since last takeDeviceChanges()
+
+    // Change observer, called by the writer (see setObserver())
+    ChangeObserver_t observer;
+    void*    observerContext;
+    uint16_t temperatureDeadband;
+    uint16_t motionDeadband;
+    uint16_t reportedTemperature[ROOM_REGISTRY_MAX_ROOMS];  // Values at the last observer call, writer-only
+    uint16_t reportedMotion[ROOM_REGISTRY_MAX_ROOMS];
+
+    uint16_t topologyCount() const {
+        return noTopology ? 0U : static_cast<uint16_t>(BUILDING_ROOM_COUNT);
+    }
+
+    uint16_t roomCount() const {                        // Slots in use
+        return static_cast<uint16_t>(topologyCount() + addedCount);
+    }
+
+    // Seqlock writer side, around every store to a slot's sensor fields
+    void beginWrite(uint16_t index);
+    void endWrite(uint16_t index);
+    void recordHistory(uint16_t index);                 // Append the slot's fields to its ring, inside a write
+    void notifyIfChanged(uint16_t index);               // Call the observer if a value moved past its deadband
+
+public:
+    // Registry of the building topology's rooms
+    constexpr RoomRegistry()
+        : addedCount(0U),
+          noTopology(false),
+          roomNumbers{},
+          temperature{},
+          motion{},
+          sampleTime{},
+          sequence{},
+          historyTemperature{},
+          historyMotion{},
+          historyTime{},
+          historyCount{},
+          deviceState{},
+          deviceDirty{},
+          observer(nullptr),
+          observerContext(nullptr),
+          temperatureDeadband(0U),
+          motionDeadband(0U),
+          reportedTemperature{},
+          reportedMotion{} {}
+
+    // Registry with no rooms until addRoom()
+    constexpr explicit RoomRegistry(RoomRegistryEmpty_t)
+        : addedCount(0U),
+          noTopology(true),
+          roomNumbers{},
+          temperature{},
+          motion{},
+          sampleTime{},
+          sequence{},
+          historyTemperature{},
+          historyMotion{},
+          historyTime{},
+          historyCount{},
+          deviceState{},
+          deviceDirty{},
+          observer(nullptr),
+          observerContext(nullptr),
+          temperatureDeadband(0U),
+          motionDeadband(0U),
+          reportedTemperature{},
+          reportedMotion{} {}
+
+    // Room management
+    uint16_t addRoom(uint16_t roomNumber);              // Slot of the new room, or ROOM_INDEX_INVALID
+    uint16_t findRoom(uint16_t roomNumber) const;       // Slot of a room, or ROOM_INDEX_INVALID
+    uint16_t getRoomCount() const;
+    uint16_t getRoomNumber(uint16_t index) const;
+    const RoomTopology_t* getTopology(uint16_t index) const;   // Table entry of a slot, or nullptr if added at runtime
+
+    // Sensors (single writer, lock-free readers)
+    void setTemperature(uint16_t index, uint16_t value);
+    void setMotion(uint16_t index, uint16_t value);
+    void setSampleTime(uint16_t index, uint32_t timestamp);
+    uint16_t getTemperature(uint16_t index) const;
+    uint16_t getMotion(uint16_t index) const;
+    uint32_t getSampleTime(uint16_t index) const;
+
+    // Change notification for every room; nullptr removes the observer
+    void setObserver(ChangeObserver_t observer, void* context, uint16_t temperatureDeadband, uint16_t motionDeadband);
+
+    // All sensors of a range of rooms at once, each room consistent; return the number of rooms copied
+    uint16_t readSamples(uint16_t first, uint16_t count, RoomSample_t* samples) const;
+    uint16_t writeSamples(uint16_t first, uint16_t count, const RoomSample_t* samples);
+
+    // The last maxSamples samples of a room, oldest first, from one state of its ring; return the
+    // number copied. recorded (may be nullptr) receives the samples ever recorded, for reading only new ones
+    uint16_t readHistory(uint16_t index, uint16_t maxSamples, RoomSample_t* samples, uint32_t* recorded) const;
+
+    // One sensor's samples recorded after the first `since`, newest SAMPLE_BLOCK_LEN at most, as one block;
+    // return block->count. block->recorded is the `since` of the next call for only new samples
+    uint16_t readBlock(uint16_t index, SensorKind_t sensor, uint32_t since, SampleBlock_t* block) const;
+
+    // Devices (atomic per bit, any task)
+    void setDevice(DeviceKind_t kind, uint16_t index, bool on);
+    bool getDevice(DeviceKind_t kind, uint16_t index) const;
+    void setLight(uint16_t index, bool on);
+    void setAC(uint16_t index, bool on);
+    void setHeater(uint16_t index, bool on);
+    bool getLight(uint16_t index) const;
+    bool getAC(uint16_t index) const;
+    bool getHeater(uint16_t index) const;
+
+    // Device deltas: take up to maxChanges changed devices and clear their dirty bits
+    uint16_t takeDeviceChanges(DeviceChange_t* changes, uint16_t maxChanges);
+    void markAllDevicesDirty();                         // Report every device on the next take, e.g. after a reconnect
+
+    // Whole-field views for passes over every room (getRoomCount() entries)
+    const uint16_t* temperatures() const;
+    const uint16_t* motions() const;
+
+    // Control decision for every room in one pass: AC above acAbove, heater below heaterBelow, light on motion
+    void controlAll(uint16_t acAbove, uint16_t heaterBelow);
+};
+
+static_assert(BUILDING_ROOM_COUNT <= ROOM_REGISTRY_MAX_ROOMS, "Building topology exceeds the registry capacity");
+static_assert((ROOM_HISTORY_DEPTH & (ROOM_HISTORY_DEPTH - 1U)) == 0U, "ROOM_HISTORY_DEPTH must be 0 or a power of two");
+
+#endif /* ROOM_REGISTRY_H_ */
@@ -0,0 +1,26 @@
+#ifndef ROOM_SAMPLE_H_
+#define ROOM_SAMPLE_H_
+
+/**
+ * @file room_sample.h
+ * @brief One room's sensor readings, copied in or out of the model as a unit.
+ * 
+ * Plain C struct shared by the C wrapper and the C++ RoomRegistry.
+*/
+
+#include <stdint.h>
+
+/** @brief Recent samples the registry keeps per room (a power of two; 0 keeps none) */
+#ifndef ROOM_HISTORY_DEPTH
+#define ROOM_HISTORY_DEPTH      (16U)
+#endif
+
+#define ROOM_HISTORY_SLOTS      ((ROOM_HISTORY_DEPTH > 0U) ? ROOM_HISTORY_DEPTH : 1U)   // Array length for a whole history
+
+typedef struct {
+    uint16_t temperature;   /**< Temperature sensor value */
+    uint16_t motion;        /**< Motion detector value */
+    uint32_t sampleTime;    /**< Creation time of the sample (tick count) */
+} RoomSample_t;
+
+#endif /* ROOM_SAMPLE_H_ */
@@ -14,6 +14,7 @@
 class Room {
 protected:
     uint16_t roomNumber;                      // Unique ID for the room
+    uint32_t sampleTime;                      // Creation time of the latest sensor sample
 
     // Sensors and devices in a room
     MotionDetector     motionDetector;
@@ -49,6 +50,10 @@ public:
     void turnOnHeater();
     void turnOffHeater();
 
+    // Creation time of the latest sensor sample, for latency tracking
+    void setSampleTime(uint32_t timestamp);
+    uint32_t getSampleTime() const;
+
     virtual ~Room() = default;                // Virtual destructor for proper cleanup
 };
 
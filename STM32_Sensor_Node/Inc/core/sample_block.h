@@ -0,0 +1,47 @@
+#ifndef SAMPLE_BLOCK_H_
+#define SAMPLE_BLOCK_H_
+
+/**
+ * @file sample_block.h
+ * @brief Aligned block of timestamped samples for high-rate sensors.
+ * 
+ * A SampleBlock_t carries a whole window of readings of one sensor in one handoff.
+ * The values come first, contiguous and aligned to SAMPLE_BLOCK_ALIGN, so an ADC
+ * or timer DMA stream can write them in place; timestamps follow in a parallel
+ * array that starts on the same alignment. RoomRegistry::readBlock() fills one
+ * from a room's sample history, and vTaskSensorRead hands it on inside the pooled
+ * SampleRecord_t. Plain C types shared by the tasks and the C++ registry.
+*/
+
+#include <stdint.h>
+
+/** @brief Samples per block; a multiple of 16 keeps both arrays aligned. Every pooled record holds one */
+#ifndef SAMPLE_BLOCK_LEN
+#define SAMPLE_BLOCK_LEN        (16U)
+#endif
+
+#define SAMPLE_BLOCK_ALIGN      (32U)       // Alignment of the block and of each array (bytes)
+
+/** @brief Sensors of a room, selecting the readings of a block */
+typedef enum {
+    SENSOR_TEMPERATURE = 0,
+    SENSOR_MOTION,
+    SENSOR_KIND_COUNT
+} SensorKind_t;
+
+typedef struct {
+    uint16_t values[SAMPLE_BLOCK_LEN];      /**< Readings, oldest first (DMA destination) */
+    uint32_t timestamps[SAMPLE_BLOCK_LEN];  /**< Creation time of each reading (tick count) */
+    uint16_t count;                         /**< Valid entries in values/timestamps */
+    uint16_t sensorId;                      /**< Sensor number of the producer (0 if not in the topology) */
+    uint32_t recorded;                      /**< Samples the producer had recorded; the newest entry is this one */
+} __attribute__((aligned(SAMPLE_BLOCK_ALIGN))) SampleBlock_t;
+
+#ifdef __cplusplus
+static_assert((SAMPLE_BLOCK_LEN % 16U) == 0U, "SAMPLE_BLOCK_LEN must be a multiple of 16");
+static_assert((sizeof(uint16_t) * SAMPLE_BLOCK_LEN) % SAMPLE_BLOCK_ALIGN == 0U, "timestamps[] must stay aligned");
+#else
+_Static_assert((SAMPLE_BLOCK_LEN % 16U) == 0U, "SAMPLE_BLOCK_LEN must be a multiple of 16");
+#endif
+
+#endif /* SAMPLE_BLOCK_H_ */
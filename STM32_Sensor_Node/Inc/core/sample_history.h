@@ -0,0 +1,118 @@
+#ifndef SAMPLE_HISTORY_H_
+#define SAMPLE_HISTORY_H_
+
+/**
+ * @file sample_history.h
+ * @brief Fixed-capacity ring of recent sensor samples, with zero-copy window views.
+ *
+ * SampleHistory<N> keeps the last N values and their timestamps in two static
+ * arrays, sized at compile time (N a power of two). Readers get a SampleWindow
+ * over the most recent samples: at most two contiguous runs of the ring, oldest
+ * first, so filters and statistics run on the stored samples without copying.
+ *
+ * Not thread-safe: a window stays valid until the next push, so the writer and
+ * the readers of one history run in the same task or are serialized:
+ *
+ *     SampleHistory<32U> history;
+ *     history.push(value, timestamp);
+ *     SampleWindow<uint16_t> last8 = history.values(8U);
+ *
+ * Sensor values shared between tasks keep their history in RoomRegistry, which
+ * records every write of a room and publishes it under the room's seqlock
+ * (RoomRegistry::readHistory()).
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief Read-only view of consecutive ring entries, oldest first.
+ *
+ * The entries are head[0 .. headLen) followed by tail[0 .. tailLen); tail is
+ * empty when the window does not wrap around the end of the ring.
+*/
+template <class T>
+struct SampleWindow {
+    const T* head;
+    uint16_t headLen;
+    const T* tail;
+    uint16_t tailLen;
+
+    uint16_t size() const {
+        return static_cast<uint16_t>(headLen + tailLen);
+    }
+
+    // i-th entry, 0 = oldest
+    const T& operator[](uint16_t i) const {
+        return (i < headLen) ? head[i] : tail[i - headLen];
+    }
+
+    // Copy the entries to dest, oldest first: one memcpy per run
+    void copyTo(T* dest) const {
+        memcpy(dest, head, headLen * sizeof(T));
+        memcpy(dest + headLen, tail, tailLen * sizeof(T));
+    }
+
+    // Call f(entry) for each entry, oldest first, one tight loop per run
+    template <class F>
+    void forEach(F f) const {
+        for (uint16_t i = 0U; i < headLen; i++) f(head[i]);
+        for (uint16_t i = 0U; i < tailLen; i++) f(tail[i]);
+    }
+};
+
+/** @brief Ring of the last Capacity samples of one sensor */
+template <uint16_t Capacity>
+class SampleHistory {
+    static_assert(Capacity > 0U && (Capacity & (Capacity - 1U)) == 0U,
+                  "SampleHistory capacity must be a power of two");
+
+private:
+    uint16_t valueRing[Capacity];               // Sensor values
+    uint32_t timeRing[Capacity];                // Creation time of each value
+    uint32_t pushed;                            // Samples ever pushed; the next slot is pushed % Capacity
+
+    // Window over the last n entries of ring (n <= size())
+    template <class T>
+    SampleWindow<T> window(const T* ring, uint16_t n) const {
+        uint16_t start = static_cast<uint16_t>((pushed - n) & (Capacity - 1U));
+        uint16_t headLen = (n < Capacity - start) ? n : static_cast<uint16_t>(Capacity - start);
+        SampleWindow<T> w = { &ring[start], headLen, ring, static_cast<uint16_t>(n - headLen) };
+        return w;
+    }
+
+public:
+    SampleHistory() : valueRing{}, timeRing{}, pushed(0U) {}
+
+    static constexpr uint16_t capacity() {
+        return Capacity;
+    }
+
+    // Record a sample, overwriting the oldest once the ring is full
+    void push(uint16_t value, uint32_t timestamp) {
+        uint16_t slot = static_cast<uint16_t>(pushed & (Capacity - 1U));
+        valueRing[slot] = value;
+        timeRing[slot]  = timestamp;
+        pushed++;
+    }
+
+    // Samples held, up to Capacity
+    uint16_t size() const {
+        return (pushed < Capacity) ? static_cast<uint16_t>(pushed) : Capacity;
+    }
+
+    void clear() {
+        pushed = 0U;
+    }
+
+    // The last n values / timestamps (all held samples if n is larger), oldest first
+    SampleWindow<uint16_t> values(uint16_t n = Capacity) const {
+        return window(valueRing, (n < size()) ? n : size());
+    }
+
+    SampleWindow<uint32_t> timestamps(uint16_t n = Capacity) const {
+        return window(timeRing, (n < size()) ? n : size());
+    }
+};
+
+#endif /* SAMPLE_HISTORY_H_ */
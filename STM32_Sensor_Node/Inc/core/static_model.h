@@ -0,0 +1,188 @@
+#ifndef STATIC_MODEL_H_
+#define STATIC_MODEL_H_
+
+/**
+ * @file static_model.h
+ * @brief Compile-time dispatched (CRTP) variant of the Sensor/Device/Room model.
+ *
+ * Same interface as sensors.h, devices.h and rooms.h, without virtual functions:
+ * StaticSensor<T> and StaticDevice<T> call into the derived type T through a
+ * static_cast, so every call is resolved and inlined at compile time. There is no
+ * vtable pointer in any object and no vtable in flash.
+ *
+ * A new type derives from the base with itself as argument and, if it needs
+ * behaviour of its own, defines the matching *Impl() hook:
+ *
+ *     class HumiditySensor : public StaticSensor<HumiditySensor> {
+ *     public:
+ *         explicit HumiditySensor(uint16_t n) : StaticSensor<HumiditySensor>(n) {}
+ *         uint16_t readValueImpl() const { return sensorValue / 10U; }
+ *     };
+ *
+ * Code that works on any sensor or device is written as a template over the
+ * base, e.g. `template <class T> void f(StaticSensor<T>& s)`. A room is a
+ * BasicRoom over its sensor and device types; StaticRoom matches Room.
+ *
+ * Header-only so the calls inline into the caller.
+*/
+
+#include <stdint.h>
+
+/** @brief Base of all compile-time dispatched sensors */
+template <class Derived>
+class StaticSensor {
+protected:
+    uint16_t sensorNumber;                      // Unique ID for the sensor
+    uint16_t sensorValue;                       // Current sensor reading
+
+    explicit StaticSensor(uint16_t sensorNumber)
+        : sensorNumber(sensorNumber), sensorValue(0U) {}
+    ~StaticSensor() = default;                  // Not deleted through the base
+
+public:
+    // Read sensor value, through Derived::readValueImpl()
+    uint16_t readValue() const {
+        return static_cast<const Derived*>(this)->readValueImpl();
+    }
+
+    void setValue(uint16_t value) {
+        sensorValue = value;
+    }
+
+    // Default hook: the stored value, as every sensor in sensors.cpp does
+    uint16_t readValueImpl() const {
+        return sensorValue;
+    }
+};
+
+/** @brief Motion detector sensor */
+class StaticMotionDetector : public StaticSensor<StaticMotionDetector> {
+public:
+    explicit StaticMotionDetector(uint16_t sensorNumber)
+        : StaticSensor<StaticMotionDetector>(sensorNumber) {}
+};
+
+/** @brief Temperature sensor */
+class StaticTemperatureSensor : public StaticSensor<StaticTemperatureSensor> {
+public:
+    explicit StaticTemperatureSensor(uint16_t sensorNumber)
+        : StaticSensor<StaticTemperatureSensor>(sensorNumber) {}
+};
+
+/** @brief Base of all compile-time dispatched devices */
+template <class Derived>
+class StaticDevice {
+protected:
+    uint16_t deviceNumber;                      // Unique ID for the device
+    bool deviceState;                           // Current state of the device (on/off)
+
+    explicit StaticDevice(uint16_t deviceNumber)
+        : deviceNumber(deviceNumber), deviceState(false) {}
+    ~StaticDevice() = default;                  // Not deleted through the base
+
+public:
+    // Switch the device, through Derived::turnOnImpl() / turnOffImpl()
+    void turnOn() {
+        static_cast<Derived*>(this)->turnOnImpl();
+    }
+
+    void turnOff() {
+        static_cast<Derived*>(this)->turnOffImpl();
+    }
+
+    bool getState() const {
+        return deviceState;
+    }
+
+    // Default hooks: record the state, as Device does
+    void turnOnImpl() {
+        deviceState = true;
+    }
+
+    void turnOffImpl() {
+        deviceState = false;
+    }
+};
+
+/** @brief Light device */
+class StaticLight : public StaticDevice<StaticLight> {
+public:
+    explicit StaticLight(uint16_t deviceNumber)
+        : StaticDevice<StaticLight>(deviceNumber) {}
+};
+
+/** @brief AC device */
+class StaticAC : public StaticDevice<StaticAC> {
+public:
+    explicit StaticAC(uint16_t deviceNumber)
+        : StaticDevice<StaticAC>(deviceNumber) {}
+};
+
+/** @brief Heater device */
+class StaticHeater : public StaticDevice<StaticHeater> {
+public:
+    explicit StaticHeater(uint16_t deviceNumber)
+        : StaticDevice<StaticHeater>(deviceNumber) {}
+};
+
+/**
+ * @brief Room over any set of sensor and device types.
+ *
+ * Interface of Room; a new room type is a new instantiation (or a class derived
+ * from one) rather than an override.
+*/
+template <class MotionT, class TemperatureT, class LightT, class ACT, class HeaterT>
+class BasicRoom {
+protected:
+    uint16_t roomNumber;                      // Unique ID for the room
+    uint32_t sampleTime;                      // Creation time of the latest sensor sample
+
+    // Sensors and devices in a room
+    MotionT      motionDetector;
+    TemperatureT tempSensor;
+    LightT       light;
+    ACT          ac;
+    HeaterT      heater;
+
+public:
+    explicit BasicRoom(uint16_t roomNumber)
+        : roomNumber(roomNumber),
+          sampleTime(0U),
+          motionDetector(roomNumber),
+          tempSensor(roomNumber),
+          light(roomNumber),
+          ac(roomNumber),
+          heater(roomNumber) {}
+
+    // Const versions for read-only access
+    const MotionT* getMotionDetector() const      { return &motionDetector; }
+    const TemperatureT* getTemperatureSensor() const { return &tempSensor; }
+    const LightT* getLight() const                { return &light; }
+    const ACT* getAC() const                      { return &ac; }
+    const HeaterT* getHeater() const              { return &heater; }
+
+    // Non-const versions for write access
+    MotionT* getMotionDetector()                  { return &motionDetector; }
+    TemperatureT* getTemperatureSensor()          { return &tempSensor; }
+    LightT* getLight()                            { return &light; }
+    ACT* getAC()                                  { return &ac; }
+    HeaterT* getHeater()                          { return &heater; }
+
+    // Methods to control devices in the room
+    void turnOnLight()    { light.turnOn(); }
+    void turnOffLight()   { light.turnOff(); }
+    void turnOnAC()       { ac.turnOn(); }
+    void turnOffAC()      { ac.turnOff(); }
+    void turnOnHeater()   { heater.turnOn(); }
+    void turnOffHeater()  { heater.turnOff(); }
+
+    // Creation time of the latest sensor sample, for latency tracking
+    void setSampleTime(uint32_t timestamp) { sampleTime = timestamp; }
+    uint32_t getSampleTime() const         { return sampleTime; }
+};
+
+/** @brief The standard room, with the same sensors and devices as Room */
+typedef BasicRoom<StaticMotionDetector, StaticTemperatureSensor,
+                  StaticLight, StaticAC, StaticHeater> StaticRoom;
+
+#endif /* STATIC_MODEL_H_ */
@@ -0,0 +1,40 @@
+#ifndef TOPOLOGY_H_
+#define TOPOLOGY_H_
+
+/**
+ * @file topology.h
+ * @brief Building topology: the node's rooms, their sensor/device IDs and thresholds.
+ * 
+ * The table is defined constexpr in topology.cpp, so it is placed in .rodata
+ * (flash) and needs no code at boot. Only the changing state of each room
+ * (sensor values, device states) lives in RAM, in the RoomRegistry.
+ * Slot i of the wrapper's registry is buildingTopology[i].
+*/
+
+#include <stdint.h>
+
+#define BUILDING_ROOM_COUNT     (1U)        // Entries in buildingTopology
+
+/** @brief Fixed description of one room */
+typedef struct {
+    uint16_t roomNumber;            /**< Unique room ID */
+    uint16_t motionSensorId;        /**< Sensor and device IDs */
+    uint16_t temperatureSensorId;
+    uint16_t lightId;
+    uint16_t acId;
+    uint16_t heaterId;
+    uint16_t acAbove;               /**< AC on above this temperature (C) */
+    uint16_t heaterBelow;           /**< Heater on below this temperature (C) */
+} RoomTopology_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const RoomTopology_t buildingTopology[BUILDING_ROOM_COUNT];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPOLOGY_H_ */
@@ -3,10 +3,21 @@
 
 /**
  * @file wrapper.h
- * @brief C-callable wrapper interface for the Room instance.
+ * @brief C-callable wrapper interface for the room registry.
+ * 
+ * The functions without a room index act on the default room (101), the first
+ * room of the building topology. The Room* functions address any registered
+ * room by slot index: topology rooms first, then those addRoom() returned.
 */
 
 #include <stdint.h>
+#include <stdbool.h>
+
+#include "room_sample.h"
+#include "sample_block.h"
+#include "device_state.h"
+#include "topology.h"
+#include "change_observer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -15,10 +26,29 @@ extern "C" {
 // Sensor setters
 void setTemperature(uint16_t value);
 void setMotion(uint16_t value);
+void setSampleTime(uint32_t timestamp);
 
 // Sensor getters
 uint16_t getTemperature(void);
 uint16_t getMotion(void);
+uint32_t getSampleTime(void);
+
+// All sensors of the default room in one call; lock-free, consistent against one writer task
+void getSensorSnapshot(RoomSample_t *sample);
+void setSensorSnapshot(const RoomSample_t *sample);
+
+// Last maxSamples samples of the default room, oldest first; return the number copied.
+// recorded (may be NULL) receives the samples ever recorded, to tell the new ones apart
+uint16_t getSensorHistory(uint16_t maxSamples, RoomSample_t *samples, uint32_t *recorded);
+
+// One sensor's samples of the default room recorded after the first `since`, as one aligned
+// block (at most SAMPLE_BLOCK_LEN, newest); block->recorded is the `since` of the next call
+uint16_t getSensorBlock(SensorKind_t sensor, uint32_t since, SampleBlock_t *block);
+
+// Change notification: observer(roomIndex, context) runs in the writer's context when a
+// room's temperature or motion differs from the last reported value by more than its deadband
+void setSensorObserver(ChangeObserver_t observer, void *context,
+                       uint16_t temperatureDeadband, uint16_t motionDeadband);
 
 // Device Control
 void turnOnLight(void);
@@ -28,6 +58,46 @@ void turnOffAC(void);
 void turnOnHeater(void);
 void turnOffHeater(void);
 
+// Room management
+uint16_t addRoom(uint16_t roomNumber);          // Slot index, or ROOM_INDEX_INVALID (0xFFFF) if full or present
+uint16_t findRoom(uint16_t roomNumber);         // Slot index, or ROOM_INDEX_INVALID
+uint16_t getRoomCount(void);
+uint16_t getRoomNumber(uint16_t index);
+
+// Building topology (flash); NULL for rooms added at runtime
+const RoomTopology_t *getTopology(void);        // Default room
+const RoomTopology_t *getRoomTopology(uint16_t index);
+
+// Per-room sensors
+void setRoomTemperature(uint16_t index, uint16_t value);
+void setRoomMotion(uint16_t index, uint16_t value);
+void setRoomSampleTime(uint16_t index, uint32_t timestamp);
+uint16_t getRoomTemperature(uint16_t index);
+uint16_t getRoomMotion(uint16_t index);
+uint32_t getRoomSampleTime(uint16_t index);
+
+// All sensors of rooms [first, first + count) in one call; return the number of rooms copied
+uint16_t getRoomSnapshots(uint16_t first, uint16_t count, RoomSample_t *samples);
+uint16_t setRoomSnapshots(uint16_t first, uint16_t count, const RoomSample_t *samples);
+uint16_t getRoomHistory(uint16_t index, uint16_t maxSamples, RoomSample_t *samples, uint32_t *recorded);
+uint16_t getRoomBlock(uint16_t index, SensorKind_t sensor, uint32_t since, SampleBlock_t *block);
+
+// Per-room devices
+void setRoomLight(uint16_t index, bool on);
+void setRoomAC(uint16_t index, bool on);
+void setRoomHeater(uint16_t index, bool on);
+bool getRoomLight(uint16_t index);
+bool getRoomAC(uint16_t index);
+bool getRoomHeater(uint16_t index);
+
+// Device deltas across all rooms: devices whose state changed since the last take
+uint16_t takeDeviceChanges(DeviceChange_t *changes, uint16_t maxChanges);   // Number of entries written
+void markAllDevicesDirty(void);                 // Report every device on the next take (full resync)
+
+// All rooms
+const uint16_t *getRoomTemperatures(void);      // getRoomCount() temperatures, by slot
+void controlAllRooms(uint16_t acAbove, uint16_t heaterBelow);
+
 #ifdef __cplusplus
 }
 #endif
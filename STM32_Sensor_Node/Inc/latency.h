@@ -0,0 +1,47 @@
+#ifndef LATENCY_H_
+#define LATENCY_H_
+
+/**
+ * @file latency.h
+ * @brief Per-stage sample latency histograms for the sensor pipeline.
+ * 
+ * Every sample is stamped when vTaskSensorWrite creates it; each task then records
+ * how long the sample took to reach it. Latencies are kept in ticks, in power-of-two
+ * buckets, so p50/p99 are reported as bucket upper bounds and max is exact.
+*/
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+#define LATENCY_HIST_BUCKETS    (16U)       // Bucket 0: 0 ticks, bucket k: [2^(k-1), 2^k - 1], last bucket open-ended
+
+/** @brief Number of transmitted samples between automatic dumps (0 = dump only on demand) */
+#ifndef LATENCY_DUMP_INTERVAL
+#define LATENCY_DUMP_INTERVAL   (60U)
+#endif
+
+/** @brief Pipeline hops that are measured */
+typedef enum {
+    LATENCY_WRITE_TO_READ = 0,              // vTaskSensorWrite -> vTaskSensorRead (Room polling)
+    LATENCY_READ_TO_CONTROLLER,             // vTaskSensorRead  -> vTaskController (xSensorQueue)
+    LATENCY_CONTROLLER_TO_TRANSMIT,         // vTaskController  -> vTaskTransmit   (xStreamBuffer)
+    LATENCY_END_TO_END,                     // vTaskSensorWrite -> vTaskTransmit
+    LATENCY_STAGE_COUNT
+} LatencyStage_t;
+
+/** @brief Summary statistics of one stage, all values in ticks */
+typedef struct {
+    uint32_t count;         /**< Number of recorded samples */
+    uint32_t p50;           /**< Upper bound of the bucket holding the median */
+    uint32_t p99;           /**< Upper bound of the bucket holding the 99th percentile */
+    uint32_t max;           /**< Largest latency recorded */
+} LatencySummary_t;
+
+// Function Prototypes
+void latency_record(LatencyStage_t stage, TickType_t ticks);
+void latency_get_summary(LatencyStage_t stage, LatencySummary_t *summary);
+void latency_reset(void);
+void latency_dump(void);
+
+#endif /* LATENCY_H_ */
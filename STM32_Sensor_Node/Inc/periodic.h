@@ -0,0 +1,45 @@
+#ifndef PERIODIC_H_
+#define PERIODIC_H_
+
+/**
+ * @file periodic.h
+ * @brief Drift-free periodic wake-ups with jitter and missed-deadline counters.
+ *
+ * A periodic task waits for absolute deadlines, each one period after the previous
+ * deadline rather than after the end of its work, so the time spent working (and any
+ * preemption) does not accumulate as drift. Every wake-up records its jitter, the
+ * ticks between the deadline and the moment the task ran. A deadline that has already
+ * passed when the task starts waiting is counted as missed; the schedule then restarts
+ * from the current tick instead of running the lost periods back to back.
+*/
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+/** @brief Periodic tasks that are tracked */
+typedef enum {
+    PERIODIC_SENSOR_WRITE = 0,              // vTaskSensorWrite, one period per sample
+    PERIODIC_SENSOR_READ,                   // vTaskSensorRead heartbeat
+    PERIODIC_TASK_COUNT
+} PeriodicTask_t;
+
+/** @brief Schedule statistics of one task, in ticks */
+typedef struct {
+    uint32_t wakeups;       /**< Deadlines reached */
+    uint32_t notified;      /**< Wake-ups by notification before the deadline (periodic_wait_notify) */
+    uint32_t missed;        /**< Deadlines already past when the task started waiting */
+    uint32_t lastJitter;    /**< Lateness of the latest wake-up */
+    uint32_t maxJitter;     /**< Largest lateness seen */
+    uint32_t totalJitter;   /**< Sum of all lateness, for the mean */
+} PeriodicStats_t;
+
+// Function Prototypes
+void        periodic_start(PeriodicTask_t task);
+BaseType_t  periodic_wait(PeriodicTask_t task, TickType_t xPeriod);
+uint32_t    periodic_wait_notify(PeriodicTask_t task, TickType_t xPeriod);
+void        periodic_get(PeriodicTask_t task, PeriodicStats_t *stats);
+const char *periodic_name(PeriodicTask_t task);
+void        periodic_reset(void);
+
+#endif /* PERIODIC_H_ */
@@ -0,0 +1,106 @@
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+/**
+ * @file profile.h
+ * @brief Cycle-counter profiling with scoped timers and named probes.
+ *
+ * Build with -DPROFILE_ENABLED=1 to turn the probes on; otherwise every macro compiles
+ * to nothing. On the STM32 the time base is the DWT cycle counter (CPU cycles); on the
+ * host build it is CLOCK_MONOTONIC (nanoseconds). Timings are inclusive: a probe
+ * nested inside another is also counted in the outer one.
+ *
+ * Usage:
+ *   static void control_devices(...)
+ *   {
+ *       PROFILE_SCOPE(PROFILE_CONTROL_DEVICES);     // Timed until the function returns
+ *       ...
+ *   }
+*/
+
+#include <stdint.h>
+
+/** @brief Enable the probes (0 = compiled out) */
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED         (0)
+#endif
+
+/** @brief Number of transmitted samples between automatic dumps (0 = dump only on demand) */
+#ifndef PROFILE_DUMP_INTERVAL
+#define PROFILE_DUMP_INTERVAL   (60U)
+#endif
+
+#if defined(HOST_BUILD)
+#include <time.h>
+#define PROFILE_UNIT            "ns"
+#else
+#include "stm32f446xx.h"
+#define PROFILE_UNIT            "cycles"
+#endif
+
+/** @brief Instrumented code paths */
+typedef enum {
+    PROFILE_CONTROL_DEVICES = 0,            // control_devices(), once per controller batch (one sample unless samples queue up)
+    PROFILE_LOG_MESSAGES,                   // log_messages() in the controller
+    PROFILE_LOG_FORMAT,                     // LOG_SENSOR_DATA / LOG_TRANSMIT_DATA formatting
+    PROFILE_UART2_WRITE,                    // One log line printed to UART2 by the Logger
+    PROFILE_PROBE_COUNT
+} ProfileProbe_t;
+
+/** @brief Statistics of one probe, in PROFILE_UNIT */
+typedef struct {
+    uint32_t calls;         /**< Number of timed calls */
+    uint32_t min;           /**< Shortest call */
+    uint32_t max;           /**< Longest call */
+    uint64_t total;         /**< Sum of all calls */
+} ProfileStats_t;
+
+/** @brief A running scoped timer, see PROFILE_SCOPE() */
+typedef struct {
+    ProfileProbe_t probe;
+    uint32_t       start;
+} ProfileScope_t;
+
+// Function Prototypes
+void profile_init(void);
+void profile_record(ProfileProbe_t probe, uint32_t elapsed);
+void profile_get(ProfileProbe_t probe, ProfileStats_t *stats);
+const char *profile_name(ProfileProbe_t probe);
+void profile_reset(void);
+void profile_dump(void);
+
+/** @brief Current time stamp, in PROFILE_UNIT; wraps, so only differences are meaningful */
+static inline uint32_t profile_now(void)
+{
+#if defined(HOST_BUILD)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+/** @brief Cleanup handler of PROFILE_SCOPE(), runs when the timer goes out of scope */
+static inline void profile_scope_end(ProfileScope_t *scope)
+{
+    profile_record(scope->probe, profile_now() - scope->start);
+}
+
+#define PROFILE_CONCAT_(a, b)   a##b
+#define PROFILE_CONCAT(a, b)    PROFILE_CONCAT_(a, b)
+
+#if PROFILE_ENABLED
+/** @brief Time the rest of the enclosing block under the given probe */
+#define PROFILE_SCOPE(probe) \
+    ProfileScope_t PROFILE_CONCAT(prof_scope_, __LINE__) \
+        __attribute__((cleanup(profile_scope_end), unused)) = { (probe), profile_now() }
+#define PROFILE_INIT()          profile_init()
+#define PROFILE_DUMP()          profile_dump()
+#else
+#define PROFILE_SCOPE(probe)    ((void)0)
+#define PROFILE_INIT()          ((void)0)
+#define PROFILE_DUMP()          ((void)0)
+#endif
+
+#endif /* PROFILE_H_ */
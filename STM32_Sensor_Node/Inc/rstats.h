@@ -0,0 +1,47 @@
+#ifndef RSTATS_H_
+#define RSTATS_H_
+
+/**
+ * @file rstats.h
+ * @brief Usage counters for the shared IPC resources.
+ * 
+ * Every send to a shared queue or stream buffer, and every take from the sample pool,
+ * is reported with rstats_record_send(), which counts successes and drops (full
+ * resource, zero timeout) and tracks the highest fill level seen right after a send.
+ * A run of consecutive drops counts as one full event, so drops / full events is the
+ * average length of an overload. Levels are in items for queues and the pool and in
+ * bytes for the stream buffer. A send that carries several items at once is reported
+ * with rstats_record_batch(), which counts each item.
+*/
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+/** @brief Resources that are tracked */
+typedef enum {
+    RSTATS_LOG_QUEUE = 0,                   // xLogQueue
+    RSTATS_SENSOR_QUEUE,                    // xSensorQueue
+    RSTATS_STREAM_BUFFER,                   // xStreamBuffer
+    RSTATS_SAMPLE_POOL,                     // Sample records (sample_pool.h)
+    RSTATS_RESOURCE_COUNT
+} RStatsResource_t;
+
+/** @brief Counters of one resource */
+typedef struct {
+    uint32_t sent;          /**< Successful sends */
+    uint32_t dropped;       /**< Sends that failed because the resource was full */
+    uint32_t fullEvents;    /**< Times the resource went from accepting to dropping */
+    uint32_t highWater;     /**< Highest fill level observed after a send */
+    uint32_t capacity;      /**< Size of the resource, in the same unit as highWater */
+} RStats_t;
+
+// Function Prototypes
+void rstats_record_send(RStatsResource_t resource, BaseType_t xSent);
+void rstats_record_batch(RStatsResource_t resource, uint32_t ulSent, uint32_t ulDropped);
+void rstats_get(RStatsResource_t resource, RStats_t *stats);
+const char *rstats_name(RStatsResource_t resource);
+uint32_t rstats_fill_pct(RStatsResource_t resource);
+void rstats_reset(void);
+
+#endif /* RSTATS_H_ */
@@ -0,0 +1,25 @@
+#ifndef SAMPLE_POOL_H_
+#define SAMPLE_POOL_H_
+
+/**
+ * @file sample_pool.h
+ * @brief Fixed pool of SampleRecord_t blocks passed by reference between tasks.
+ *
+ * SAMPLE_POOL_SIZE records in static storage. vTaskSensorRead takes a record, the
+ * pointer is handed from task to task through xSensorQueue and xStreamBuffer, and
+ * vTaskTransmit gives it back, so a sample is written once and never copied between
+ * stages. A task that cannot pass a record on (full queue or stream buffer) gives it
+ * back itself. Take and give are O(1) and safe from any task. Takes are accounted
+ * in rstats as RSTATS_SAMPLE_POOL, like sends to a queue.
+*/
+
+#include <stdint.h>
+
+#include "shared_resources.h"
+
+// Function Prototypes
+SampleRecord_t *sample_pool_take(void);
+void            sample_pool_give(SampleRecord_t *record);
+uint32_t        sample_pool_in_use(void);
+
+#endif /* SAMPLE_POOL_H_ */
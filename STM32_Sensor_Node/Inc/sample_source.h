@@ -0,0 +1,63 @@
+#ifndef SAMPLE_SOURCE_H_
+#define SAMPLE_SOURCE_H_
+
+/**
+ * @file sample_source.h
+ * @brief Pluggable sample source (load generator) for vTaskSensorWrite.
+ * 
+ * Generates simulated temperature/motion samples in one of several modes and
+ * paces them at a configurable rate, so the pipeline can be driven from the
+ * legacy 10 s period up to one sample per tick.
+*/
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+/** @brief Mode used at boot (see SampleSourceMode_t) */
+#ifndef SAMPLE_SOURCE_MODE
+#define SAMPLE_SOURCE_MODE          SAMPLE_SOURCE_RANDOM
+#endif
+
+/** @brief Rate used at boot, in millihertz (100 = one sample every 10 s, 1000000 = 1 kHz) */
+#ifndef SAMPLE_SOURCE_RATE_MHZ
+#define SAMPLE_SOURCE_RATE_MHZ      (100U)
+#endif
+
+/** @brief Sample generation modes */
+typedef enum {
+    SAMPLE_SOURCE_RANDOM = 0,       // rand(): temperature 0-99, motion 0-1
+    SAMPLE_SOURCE_CONSTANT,         // Same value every sample
+    SAMPLE_SOURCE_RAMP,             // Temperature sweeps min..max, motion toggles on every wrap
+    SAMPLE_SOURCE_TABLE,            // Values replayed cyclically from a table
+    SAMPLE_SOURCE_BURST,            // burstLength samples at the configured rate, then burstGapMs idle
+} SampleSourceMode_t;
+
+/** @brief One generated sample */
+typedef struct {
+    uint16_t temperature;
+    uint16_t motion;
+} SampleValue_t;
+
+/** @brief Sample source configuration */
+typedef struct {
+    SampleSourceMode_t   mode;
+    uint32_t             rateMilliHz;   /**< Sample rate in mHz, capped at one sample per tick */
+    SampleValue_t        constant;      /**< CONSTANT: value emitted every sample */
+    uint16_t             rampMin;       /**< RAMP: lowest temperature */
+    uint16_t             rampMax;       /**< RAMP: highest temperature */
+    uint16_t             rampStep;      /**< RAMP: temperature increment per sample */
+    const SampleValue_t *table;         /**< TABLE: scripted samples, NULL for the built-in script */
+    uint32_t             tableLength;   /**< TABLE: number of entries in table */
+    uint32_t             burstLength;   /**< BURST: samples per burst */
+    uint32_t             burstGapMs;    /**< BURST: idle time between bursts */
+} SampleSourceConfig_t;
+
+// Function Prototypes
+void       sample_source_configure(const SampleSourceConfig_t *config);
+void       sample_source_get_config(SampleSourceConfig_t *config);
+void       sample_source_next(SampleValue_t *sample);
+TickType_t sample_source_next_delay(void);
+TickType_t sample_source_period_ticks(void);
+
+#endif /* SAMPLE_SOURCE_H_ */
@@ -8,39 +8,37 @@
 
 #include "FreeRTOS.h"
 #include "queue.h"
-#include "semphr.h"
 #include "stream_buffer.h"
 
+#include "sample_block.h"
+
 #define LOG_MSG_MAX_LEN         (128U)
 #define LOG_QUEUE_DEPTH         (20U)
 #define SENSOR_QUEUE_DEPTH      (20U)
-#define STREAM_BUFFER_SIZE      ((size_t) 256U)
+#define SAMPLE_POOL_SIZE        (32U)           // Sample records in flight, see sample_pool.h
+#define STREAM_BUFFER_SIZE      ((size_t) (SAMPLE_POOL_SIZE * sizeof(SampleRecord_t *)))
 
 /**
- * @brief Sensor data structure.
+ * @brief One sensor sample on its way from vTaskSensorRead to vTaskTransmit.
  * 
- * Contains the latest temperature and motion readings from the Room's sensors.
- * Transmitted via xSensorQueue from vTaskSensorRead to vTaskController.
-*/
-typedef struct {
-    uint16_t temperature;   /**< Temperature sensor reading */
-    uint16_t motion;        /**< Motion detector value */
-} SensorData_t;
-
-/**
- * @brief Transmission data structure sent to ESP32.
+ * Records live in the sample pool (sample_pool.h). vTaskSensorRead takes one and
+ * fills it, then only its pointer travels: through xSensorQueue to vTaskController,
+ * which adds its timestamp, and through xStreamBuffer to vTaskTransmit, which gives
+ * it back to the pool. Whichever task holds the pointer owns the record.
  * 
- * Extends SensorData_t with a timestamp for event correlation and data logging.
- * Written to xStreamBuffer by vTaskController, read by vTaskTransmit.
+ * Besides the snapshot, a record carries the temperature samples recorded since the
+ * previous record as one SampleBlock_t, so the window moves with the pointer.
 */
 typedef struct {
-    uint16_t temperature;
-    uint16_t motion;
-    TickType_t timestamp;
-} TransmitData_t;
+    uint16_t   temperature; /**< Temperature sensor reading */
+    uint16_t   motion;      /**< Motion detector value */
+    TickType_t timestamp;   /**< Tick at which vTaskController forwarded the sample */
+    TickType_t sampledAt;   /**< Tick at which vTaskSensorWrite created the sample */
+    TickType_t readAt;      /**< Tick at which vTaskSensorRead read it from the Room */
+    SampleBlock_t temperatureWindow;    /**< Temperature samples since the previous record, oldest first */
+} SampleRecord_t;
 
 // Global resource handles
-extern SemaphoreHandle_t    xSensorMutex;
 extern QueueHandle_t        xLogQueue;
 extern QueueHandle_t        xSensorQueue;
 extern StreamBufferHandle_t xStreamBuffer;
@@ -0,0 +1,33 @@
+#ifndef SOAK_MONITOR_H_
+#define SOAK_MONITOR_H_
+
+/**
+ * @file soak_monitor.h
+ * @brief Periodic heap and IPC backlog report for long (soak) runs.
+ * 
+ * Build with -DSOAK_MONITOR to create vTaskSoakMonitor. It is enabled automatically
+ * by the virtual-time simulation (`make sim`, -DSIM_VIRTUAL_TIME), where a simulated
+ * day completes in seconds of wall-clock time.
+*/
+
+#if defined(SIM_VIRTUAL_TIME) && !defined(SOAK_MONITOR)
+#define SOAK_MONITOR
+#endif
+
+/** @brief Simulated seconds between reports */
+#ifndef SOAK_REPORT_INTERVAL_S
+#define SOAK_REPORT_INTERVAL_S  (3600U)
+#endif
+
+/** @brief Length of the run in simulated seconds; the host build exits after it (0 = run forever) */
+#ifndef SOAK_DURATION_S
+#if defined(SIM_VIRTUAL_TIME)
+#define SOAK_DURATION_S         (86400U)
+#else
+#define SOAK_DURATION_S         (0U)
+#endif
+#endif
+
+#define SOAK_MAX_TASKS          (12U)       // Tasks listed in the final stack report
+
+#endif /* SOAK_MONITOR_H_ */
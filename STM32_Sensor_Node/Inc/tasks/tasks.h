@@ -10,15 +10,23 @@
 #include "task.h"
 #include "queue.h"
 
+#include "profile.h"
+
 // Macros for consistent log formatting
 #define LOG_SENSOR_DATA(msg, taskname, action, temp, motion) \
-    snprintf(msg, sizeof(msg), "[%-12s] %-18s Temp: %3u  Motion: %u", \
-            taskname, action, (unsigned int)(temp), (unsigned int)(motion))
+    do { \
+        PROFILE_SCOPE(PROFILE_LOG_FORMAT); \
+        snprintf(msg, sizeof(msg), "[%-12s] %-18s Temp: %3u  Motion: %u", \
+                taskname, action, (unsigned int)(temp), (unsigned int)(motion)); \
+    } while (0)
 
 // Macro for logging transmit data with timestamp
 #define LOG_TRANSMIT_DATA(msg,taskname, action, temp, motion, ts) \
-    snprintf(msg, sizeof(msg), "[%-12s] %-18s Temp: %3u  Motion: %u  Timestamp: %lu", \
-             taskname, action, (unsigned int)(temp), (unsigned int)(motion), (unsigned long)(ts))
+    do { \
+        PROFILE_SCOPE(PROFILE_LOG_FORMAT); \
+        snprintf(msg, sizeof(msg), "[%-12s] %-18s Temp: %3u  Motion: %u  Timestamp: %lu", \
+                 taskname, action, (unsigned int)(temp), (unsigned int)(motion), (unsigned long)(ts)); \
+    } while (0)
 
 
 void vTaskSensorWrite(void *pvParameters);
@@ -26,5 +34,6 @@ void vTaskSensorRead(void *pvParameters);
 void vTaskController(void *pvParameters);
 void vTaskTransmit(void *pvParameters);
 void vTaskLogger(void *pvParameters);
+void vTaskSoakMonitor(void *pvParameters);
 
 #endif // TASKS_H 
\ No newline at end of file
@@ -0,0 +1,82 @@
+/**
+ * @file backpressure.c
+ * @brief Adaptive sample-rate backpressure for the sensor pipeline.
+ *
+ * Only vTaskSensorWrite updates the state, so updates take no lock. Readers copy
+ * it inside a critical section.
+*/
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "backpressure.h"
+#include "rstats.h"
+
+static BackpressureStats_t state;
+
+// Local function prototypes
+static uint32_t pipeline_fill_pct(void);
+
+/**
+ * @brief Adjust the backpressure level to the pipeline fill and scale a delay by it.
+ *
+ * Must only be called by vTaskSensorWrite, once per sample.
+ *
+ * @param xDelay  Delay to the next sample requested by the sample source.
+ * @return xDelay doubled once per backpressure level, saturating at portMAX_DELAY
+ *         (a paused source's portMAX_DELAY is returned unchanged).
+*/
+TickType_t backpressure_scale_delay(TickType_t xDelay)
+{
+    uint32_t ulFill = pipeline_fill_pct();
+
+    if (ulFill >= BACKPRESSURE_HIGH_PCT && state.level < BACKPRESSURE_MAX_LEVEL) {
+        state.level++;
+        state.throttles++;
+        if (state.level > state.maxLevel) {
+            state.maxLevel = state.level;
+        }
+    } else if (ulFill <= BACKPRESSURE_LOW_PCT && state.level > 0U) {
+        state.level--;
+    }
+    state.fillPct = ulFill;
+
+    if (xDelay > (TickType_t)(portMAX_DELAY >> state.level)) {
+        return portMAX_DELAY;       // Shifting would wrap to a shorter delay
+    }
+    return (TickType_t)(xDelay << state.level);
+}
+
+/** @brief Copy the backpressure state and counters */
+void backpressure_get(BackpressureStats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = state;
+    taskEXIT_CRITICAL();
+}
+
+/** @brief Fill level of the fullest resource the sample path depends on */
+static uint32_t pipeline_fill_pct(void)
+{
+    static const RStatsResource_t resources[] = {
+        RSTATS_SENSOR_QUEUE,
+        RSTATS_STREAM_BUFFER,
+        RSTATS_SAMPLE_POOL,
+    };
+    uint32_t ulMax = 0U;
+    uint32_t ulFill;
+
+    for (uint32_t i = 0U; i < sizeof(resources) / sizeof(resources[0]); i++) {
+        ulFill = rstats_fill_pct(resources[i]);
+        if (ulFill > ulMax) {
+            ulMax = ulFill;
+        }
+    }
+    return ulMax;
+}
@@ -0,0 +1,410 @@
+/**
+ * @file room_registry.cpp
+ * @brief Implementation of the struct-of-arrays RoomRegistry.
+ *
+ * Accessors with an out-of-range slot are ignored (setters) or return 0/false
+ * (getters), as the wrapper has no error path to report them.
+ *
+ * Sensor fields are read and written with relaxed __atomic builtins, which are
+ * plain loads and stores on the Cortex-M4; the per-slot sequence counter orders
+ * them. Single fields are consistent on their own, readSamples() gives a
+ * consistent set of fields and readHistory() a consistent window of samples.
+*/
+
+#include <stdint.h>
+#include "room_registry.h"
+
+uint16_t RoomRegistry::addRoom(uint16_t roomNumber) {
+    if (roomCount() >= ROOM_REGISTRY_MAX_ROOMS || findRoom(roomNumber) != ROOM_INDEX_INVALID) {
+        return ROOM_INDEX_INVALID;
+    }
+    uint16_t slot = roomCount();
+    roomNumbers[slot] = roomNumber;
+    addedCount++;
+    return slot;
+}
+
+uint16_t RoomRegistry::findRoom(uint16_t roomNumber) const {
+    uint16_t rooms = roomCount();
+    for (uint16_t i = 0U; i < rooms; i++) {
+        if (getRoomNumber(i) == roomNumber) {
+            return i;
+        }
+    }
+    return ROOM_INDEX_INVALID;
+}
+
+uint16_t RoomRegistry::getRoomCount() const {
+    return roomCount();
+}
+
+uint16_t RoomRegistry::getRoomNumber(uint16_t index) const {
+    if (index < topologyCount()) {
+        return buildingTopology[index].roomNumber;
+    }
+    return (index < roomCount()) ? roomNumbers[index] : 0U;
+}
+
+const RoomTopology_t* RoomRegistry::getTopology(uint16_t index) const {
+    return (index < topologyCount()) ? &buildingTopology[index] : nullptr;
+}
+
+/** @brief Mark a slot as being written; readers retry until endWrite() */
+void RoomRegistry::beginWrite(uint16_t index) {
+    __atomic_store_n(&sequence[index], sequence[index] + 1U, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);        // Odd count visible before any field store
+}
+
+/** @brief Publish a slot's new sensor fields */
+void RoomRegistry::endWrite(uint16_t index) {
+    __atomic_store_n(&sequence[index], sequence[index] + 1U, __ATOMIC_RELEASE);
+}
+
+/** @brief Writer side, between beginWrite() and endWrite(): record the slot's fields as its newest sample */
+void RoomRegistry::recordHistory(uint16_t index) {
+    if (ROOM_HISTORY_DEPTH == 0U) {
+        return;
+    }
+    uint32_t recorded = historyCount[index];            // Writer-owned, no atomics needed to read back
+    uint16_t entry = static_cast<uint16_t>(recorded & (ROOM_HISTORY_SLOTS - 1U));
+    __atomic_store_n(&historyTemperature[index][entry], temperature[index], __ATOMIC_RELAXED);
+    __atomic_store_n(&historyMotion[index][entry], motion[index], __ATOMIC_RELAXED);
+    __atomic_store_n(&historyTime[index][entry], sampleTime[index], __ATOMIC_RELAXED);
+    __atomic_store_n(&historyCount[index], recorded + 1U, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Install the change observer for all rooms.
+ *
+ * Called by the consumer, possibly while the writer runs: the deadbands and
+ * context are published before the observer pointer that makes them used.
+ * @param temperatureDeadband, motionDeadband Largest change from the last reported
+ *        value that does not notify; 0 notifies on every change.
+*/
+void RoomRegistry::setObserver(ChangeObserver_t newObserver, void* context,
+                               uint16_t newTemperatureDeadband, uint16_t newMotionDeadband) {
+    __atomic_store_n(&observer, static_cast<ChangeObserver_t>(nullptr), __ATOMIC_RELAXED);
+    observerContext     = context;
+    temperatureDeadband = newTemperatureDeadband;
+    motionDeadband      = newMotionDeadband;
+    __atomic_store_n(&observer, newObserver, __ATOMIC_RELEASE);
+}
+
+/** @brief Writer side: notify once per write if either sensor moved past its deadband */
+void RoomRegistry::notifyIfChanged(uint16_t index) {
+    ChangeObserver_t notify = __atomic_load_n(&observer, __ATOMIC_ACQUIRE);
+    if (notify == nullptr) {
+        return;
+    }
+    uint16_t t = temperature[index];                    // Writer-owned, no atomics needed to read back
+    uint16_t m = motion[index];
+    uint16_t tChange = (t > reportedTemperature[index]) ? (t - reportedTemperature[index]) : (reportedTemperature[index] - t);
+    uint16_t mChange = (m > reportedMotion[index]) ? (m - reportedMotion[index]) : (reportedMotion[index] - m);
+    if (tChange > temperatureDeadband || mChange > motionDeadband) {
+        reportedTemperature[index] = t;
+        reportedMotion[index]      = m;
+        notify(index, observerContext);
+    }
+}
+
+void RoomRegistry::setTemperature(uint16_t index, uint16_t value) {
+    if (index < roomCount()) {
+        beginWrite(index);
+        __atomic_store_n(&temperature[index], value, __ATOMIC_RELAXED);
+        recordHistory(index);
+        endWrite(index);
+        notifyIfChanged(index);
+    }
+}
+
+void RoomRegistry::setMotion(uint16_t index, uint16_t value) {
+    if (index < roomCount()) {
+        beginWrite(index);
+        __atomic_store_n(&motion[index], value, __ATOMIC_RELAXED);
+        recordHistory(index);
+        endWrite(index);
+        notifyIfChanged(index);
+    }
+}
+
+void RoomRegistry::setSampleTime(uint16_t index, uint32_t timestamp) {
+    if (index < roomCount()) {
+        beginWrite(index);
+        __atomic_store_n(&sampleTime[index], timestamp, __ATOMIC_RELAXED);
+        recordHistory(index);
+        endWrite(index);
+    }
+}
+
+uint16_t RoomRegistry::getTemperature(uint16_t index) const {
+    return (index < roomCount()) ? __atomic_load_n(&temperature[index], __ATOMIC_RELAXED) : 0U;
+}
+
+uint16_t RoomRegistry::getMotion(uint16_t index) const {
+    return (index < roomCount()) ? __atomic_load_n(&motion[index], __ATOMIC_RELAXED) : 0U;
+}
+
+uint32_t RoomRegistry::getSampleTime(uint16_t index) const {
+    return (index < roomCount()) ? __atomic_load_n(&sampleTime[index], __ATOMIC_RELAXED) : 0U;
+}
+
+/**
+ * @brief Copy the sensors of rooms [first, first + count) into samples.
+ *
+ * Never blocks. Each room is copied again if its sequence count was odd or
+ * changed during the copy, so every sample comes from one completed write.
+ * @return Number of rooms copied, fewer than count if the range passes the last room.
+*/
+uint16_t RoomRegistry::readSamples(uint16_t first, uint16_t count, RoomSample_t* samples) const {
+    uint16_t rooms = roomCount();
+    if (first >= rooms) {
+        return 0U;
+    }
+    if (count > rooms - first) {
+        count = static_cast<uint16_t>(rooms - first);
+    }
+    for (uint16_t i = 0U; i < count; i++) {
+        uint16_t slot = static_cast<uint16_t>(first + i);
+        uint32_t seq;
+        do {
+            seq = __atomic_load_n(&sequence[slot], __ATOMIC_ACQUIRE);
+            samples[i].temperature = __atomic_load_n(&temperature[slot], __ATOMIC_RELAXED);
+            samples[i].motion      = __atomic_load_n(&motion[slot], __ATOMIC_RELAXED);
+            samples[i].sampleTime  = __atomic_load_n(&sampleTime[slot], __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);    // Field loads complete before the re-check
+        } while (((seq & 1U) != 0U) || (seq != __atomic_load_n(&sequence[slot], __ATOMIC_RELAXED)));
+    }
+    return count;
+}
+
+/**
+ * @brief Store samples as the sensors of rooms [first, first + count).
+ *
+ * Single writer only: each room is published under its seqlock.
+ * @return Number of rooms written, fewer than count if the range passes the last room.
+*/
+uint16_t RoomRegistry::writeSamples(uint16_t first, uint16_t count, const RoomSample_t* samples) {
+    uint16_t rooms = roomCount();
+    if (first >= rooms) {
+        return 0U;
+    }
+    if (count > rooms - first) {
+        count = static_cast<uint16_t>(rooms - first);
+    }
+    for (uint16_t i = 0U; i < count; i++) {
+        uint16_t slot = static_cast<uint16_t>(first + i);
+        beginWrite(slot);
+        __atomic_store_n(&temperature[slot], samples[i].temperature, __ATOMIC_RELAXED);
+        __atomic_store_n(&motion[slot], samples[i].motion, __ATOMIC_RELAXED);
+        __atomic_store_n(&sampleTime[slot], samples[i].sampleTime, __ATOMIC_RELAXED);
+        recordHistory(slot);
+        endWrite(slot);
+        notifyIfChanged(slot);
+    }
+    return count;
+}
+
+/**
+ * @brief Copy the newest samples of a room's history into samples, oldest first.
+ *
+ * Never blocks. The whole window is copied again if the writer recorded a sample
+ * meanwhile, so it comes from one state of the ring: consecutive samples, none
+ * overwritten halfway. Every write to the room recorded one sample, including
+ * single-field setters, which record the room's fields after the store.
+ * @param recorded Samples recorded since start-up (wraps at 2^32), taken with the
+ *        window; a caller keeps the previous value to tell which samples are new.
+ * @return Number of samples copied: maxSamples, or fewer while the ring is filling
+ *         up, at most ROOM_HISTORY_DEPTH (0 if disabled or index is out of range).
+*/
+uint16_t RoomRegistry::readHistory(uint16_t index, uint16_t maxSamples, RoomSample_t* samples,
+                                   uint32_t* recorded) const {
+    uint32_t seq;
+    uint32_t count = 0U;
+    uint16_t n = 0U;
+
+    if (index < roomCount()) {
+        do {
+            seq   = __atomic_load_n(&sequence[index], __ATOMIC_ACQUIRE);
+            count = __atomic_load_n(&historyCount[index], __ATOMIC_RELAXED);
+            n = (count < ROOM_HISTORY_DEPTH) ? static_cast<uint16_t>(count) : static_cast<uint16_t>(ROOM_HISTORY_DEPTH);
+            n = (n < maxSamples) ? n : maxSamples;
+            for (uint16_t i = 0U; i < n; i++) {
+                uint16_t entry = static_cast<uint16_t>((count - n + i) & (ROOM_HISTORY_SLOTS - 1U));
+                samples[i].temperature = __atomic_load_n(&historyTemperature[index][entry], __ATOMIC_RELAXED);
+                samples[i].motion      = __atomic_load_n(&historyMotion[index][entry], __ATOMIC_RELAXED);
+                samples[i].sampleTime  = __atomic_load_n(&historyTime[index][entry], __ATOMIC_RELAXED);
+            }
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);    // Entry loads complete before the re-check
+        } while (((seq & 1U) != 0U) || (seq != __atomic_load_n(&sequence[index], __ATOMIC_RELAXED)));
+    }
+    if (recorded != nullptr) {
+        *recorded = count;
+    }
+    return n;
+}
+
+/**
+ * @brief Copy one sensor's samples recorded since a caller's previous read into block.
+ *
+ * Same seqlock retry as readHistory(), so the block holds consecutive samples of
+ * completed writes. The sensor ID comes from the building topology.
+ * @param since  Samples recorded as of the previous read (block->recorded of that
+ *        read); 0 takes the newest samples held. Samples already overwritten in the
+ *        ring, or more than SAMPLE_BLOCK_LEN, are skipped (the oldest ones).
+ * @return Number of samples copied (block->count), 0 if none is new or index is
+ *         out of range.
+*/
+uint16_t RoomRegistry::readBlock(uint16_t index, SensorKind_t sensor, uint32_t since, SampleBlock_t* block) const {
+    const uint16_t* ring = nullptr;
+    uint32_t seq;
+    uint32_t count = 0U;
+    uint16_t n = 0U;
+
+    if (index < roomCount() && sensor < SENSOR_KIND_COUNT) {
+        ring = (sensor == SENSOR_TEMPERATURE) ? historyTemperature[index] : historyMotion[index];
+        do {
+            seq   = __atomic_load_n(&sequence[index], __ATOMIC_ACQUIRE);
+            count = __atomic_load_n(&historyCount[index], __ATOMIC_RELAXED);
+            uint32_t fresh = count - since;
+            n = (count < ROOM_HISTORY_DEPTH) ? static_cast<uint16_t>(count) : static_cast<uint16_t>(ROOM_HISTORY_DEPTH);
+            n = (fresh < n) ? static_cast<uint16_t>(fresh) : n;
+            n = (n < SAMPLE_BLOCK_LEN) ? n : static_cast<uint16_t>(SAMPLE_BLOCK_LEN);
+            for (uint16_t i = 0U; i < n; i++) {
+                uint16_t entry = static_cast<uint16_t>((count - n + i) & (ROOM_HISTORY_SLOTS - 1U));
+                block->values[i]     = __atomic_load_n(&ring[entry], __ATOMIC_RELAXED);
+                block->timestamps[i] = __atomic_load_n(&historyTime[index][entry], __ATOMIC_RELAXED);
+            }
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);    // Entry loads complete before the re-check
+        } while (((seq & 1U) != 0U) || (seq != __atomic_load_n(&sequence[index], __ATOMIC_RELAXED)));
+    }
+
+    const RoomTopology_t* topology = getTopology(index);
+    block->count    = n;
+    block->sensorId = (topology == nullptr) ? 0U
+                    : (sensor == SENSOR_TEMPERATURE) ? topology->temperatureSensorId : topology->motionSensorId;
+    block->recorded = count;
+    return n;
+}
+
+/**
+ * @brief Switch one device; a change of state marks it dirty.
+ *
+ * Atomic read-modify-write of the bitmap word, so tasks updating other rooms
+ * or other devices of the same word do not lose each other's bits.
+*/
+void RoomRegistry::setDevice(DeviceKind_t kind, uint16_t index, bool on) {
+    if (index >= roomCount() || kind >= DEVICE_KIND_COUNT) {
+        return;
+    }
+    uint32_t bit = 1UL << (index % 32U);
+    uint32_t* word = &deviceState[kind][index / 32U];
+    uint32_t old = on ? __atomic_fetch_or(word, bit, __ATOMIC_RELAXED)
+                      : __atomic_fetch_and(word, ~bit, __ATOMIC_RELAXED);
+    if (((old & bit) != 0U) != on) {
+        __atomic_fetch_or(&deviceDirty[kind][index / 32U], bit, __ATOMIC_RELEASE);
+    }
+}
+
+bool RoomRegistry::getDevice(DeviceKind_t kind, uint16_t index) const {
+    if (index >= roomCount() || kind >= DEVICE_KIND_COUNT) {
+        return false;
+    }
+    return (__atomic_load_n(&deviceState[kind][index / 32U], __ATOMIC_RELAXED) >> (index % 32U)) & 1U;
+}
+
+void RoomRegistry::setLight(uint16_t index, bool on)  { setDevice(DEVICE_LIGHT, index, on);  }
+void RoomRegistry::setAC(uint16_t index, bool on)     { setDevice(DEVICE_AC, index, on);     }
+void RoomRegistry::setHeater(uint16_t index, bool on) { setDevice(DEVICE_HEATER, index, on); }
+bool RoomRegistry::getLight(uint16_t index) const     { return getDevice(DEVICE_LIGHT, index);  }
+bool RoomRegistry::getAC(uint16_t index) const        { return getDevice(DEVICE_AC, index);     }
+bool RoomRegistry::getHeater(uint16_t index) const    { return getDevice(DEVICE_HEATER, index); }
+
+/**
+ * @brief Report devices changed since the last call, with their current state.
+ *
+ * Takes each dirty word atomically, so a change made while this runs is
+ * reported now or on the next call, never lost. Dirty bits beyond maxChanges
+ * are put back for the next call.
+ * @return Number of entries written to changes.
+*/
+uint16_t RoomRegistry::takeDeviceChanges(DeviceChange_t* changes, uint16_t maxChanges) {
+    uint16_t count = 0U;
+
+    for (uint16_t kind = 0U; kind < DEVICE_KIND_COUNT; kind++) {
+        for (uint16_t w = 0U; w < DEVICE_BITMAP_WORDS; w++) {
+            if (__atomic_load_n(&deviceDirty[kind][w], __ATOMIC_RELAXED) == 0U) {
+                continue;
+            }
+            if (count >= maxChanges) {
+                return count;
+            }
+            uint32_t dirty = __atomic_exchange_n(&deviceDirty[kind][w], 0U, __ATOMIC_ACQUIRE);
+            uint32_t state = __atomic_load_n(&deviceState[kind][w], __ATOMIC_RELAXED);
+            while (dirty != 0U && count < maxChanges) {
+                uint32_t bit = static_cast<uint32_t>(__builtin_ctz(dirty));
+                changes[count].roomIndex = static_cast<uint16_t>(w * 32U + bit);
+                changes[count].kind      = static_cast<uint8_t>(kind);
+                changes[count].on        = static_cast<uint8_t>((state >> bit) & 1U);
+                count++;
+                dirty &= dirty - 1U;                                // Clear the lowest set bit
+            }
+            if (dirty != 0U) {
+                __atomic_fetch_or(&deviceDirty[kind][w], dirty, __ATOMIC_RELAXED);
+            }
+        }
+    }
+    return count;
+}
+
+void RoomRegistry::markAllDevicesDirty() {
+    uint16_t rooms = roomCount();
+    for (uint16_t kind = 0U; kind < DEVICE_KIND_COUNT; kind++) {
+        for (uint16_t w = 0U; w < DEVICE_BITMAP_WORDS; w++) {
+            uint32_t used = (rooms >= (w + 1U) * 32U) ? 0xFFFFFFFFUL
+                          : (rooms > w * 32U)         ? ((1UL << (rooms - w * 32U)) - 1U)
+                          : 0U;
+            __atomic_fetch_or(&deviceDirty[kind][w], used, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+const uint16_t* RoomRegistry::temperatures() const {
+    return temperature;
+}
+
+const uint16_t* RoomRegistry::motions() const {
+    return motion;
+}
+
+/**
+ * @brief Apply the controller's rules to every room.
+ *
+ * Same decision as control_devices() in task_controller.c, computed 32 rooms at
+ * a time into whole bitmap words. Each word is swapped in atomically and the
+ * bits that changed are marked dirty.
+*/
+void RoomRegistry::controlAll(uint16_t acAbove, uint16_t heaterBelow) {
+    uint16_t rooms = roomCount();
+    for (uint16_t w = 0U; w * 32U < rooms; w++) {
+        uint32_t acBits = 0U;
+        uint32_t heaterBits = 0U;
+        uint32_t lightBits = 0U;
+        uint16_t end = (rooms - w * 32U > 32U) ? static_cast<uint16_t>(w * 32U + 32U) : rooms;
+
+        for (uint16_t i = static_cast<uint16_t>(w * 32U); i < end; i++) {
+            uint16_t t = __atomic_load_n(&temperature[i], __ATOMIC_RELAXED);
+            uint32_t bit = 1UL << (i % 32U);
+            acBits     |= (t > acAbove) ? bit : 0U;
+            heaterBits |= (t < heaterBelow) ? bit : 0U;
+            lightBits  |= (__atomic_load_n(&motion[i], __ATOMIC_RELAXED) > 0U) ? bit : 0U;
+        }
+
+        const uint32_t next[DEVICE_KIND_COUNT] = { lightBits, acBits, heaterBits };  // By DeviceKind_t
+        for (uint16_t kind = 0U; kind < DEVICE_KIND_COUNT; kind++) {
+            uint32_t old = __atomic_exchange_n(&deviceState[kind][w], next[kind], __ATOMIC_RELAXED);
+            if (old != next[kind]) {
+                __atomic_fetch_or(&deviceDirty[kind][w], old ^ next[kind], __ATOMIC_RELEASE);
+            }
+        }
+    }
+}
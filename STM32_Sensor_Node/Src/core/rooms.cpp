@@ -9,6 +9,7 @@
 /** @brief Room base class Implementation */
 Room::Room(uint16_t roomNumber) 
     : roomNumber(roomNumber),
+      sampleTime(0U),
       motionDetector(roomNumber),
       tempSensor(roomNumber),
       light(roomNumber),
@@ -79,3 +80,10 @@ void Room::turnOffHeater() {
     heater.turnOff();
 }
 
+void Room::setSampleTime(uint32_t timestamp) {
+    sampleTime = timestamp;
+}
+
+uint32_t Room::getSampleTime() const {
+    return sampleTime;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file topology.cpp
+ * @brief The node's building topology, constant and checked at compile time.
+ * 
+ * Add a room by appending an entry and raising BUILDING_ROOM_COUNT.
+*/
+
+#include <stdint.h>
+#include "topology.h"
+
+extern "C" constexpr RoomTopology_t buildingTopology[BUILDING_ROOM_COUNT] = {
+    // room  motion  temp  light  AC   heater  AC above  heater below
+    {  101U, 101U,   101U, 101U,  101U, 101U,  25U,      20U },
+};
+
+namespace {
+
+/** @brief Room numbers are unique and each room's AC threshold is not below its heater threshold */
+constexpr bool topologyValid() {
+    for (uint16_t i = 0U; i < BUILDING_ROOM_COUNT; i++) {
+        if (buildingTopology[i].acAbove < buildingTopology[i].heaterBelow) {
+            return false;
+        }
+        for (uint16_t j = 0U; j < i; j++) {
+            if (buildingTopology[j].roomNumber == buildingTopology[i].roomNumber) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+static_assert(BUILDING_ROOM_COUNT > 0U, "The topology needs at least the default room");
+static_assert(topologyValid(), "Duplicate room number or AC threshold below heater threshold");
@@ -1,38 +1,132 @@
 /**
  * @file wrapper.cpp
- * @brief C-callable wrapper implementation for the Room instance.
+ * @brief C-callable wrapper implementation for the room registry.
+ * 
+ * The registry starts with the rooms of the building topology (topology.h).
+ * The legacy single-room API acts on the topology's first room (101), slot 0.
 */
 
 #include <stdint.h>
 
-#include "rooms.h"
+#include "room_registry.h"
 #include "wrapper.h"
 
-// Allocate a room
-static Room room(101U);
+// Starts with the topology's rooms; all zero, so in .bss with no constructor at boot
+static RoomRegistry registry;
+static constexpr uint16_t defaultRoom = 0U;
 
 // Sensor setters
 void setTemperature(uint16_t value) {
-    room.getTemperatureSensor()->setValue(value);
+    registry.setTemperature(defaultRoom, value);
 }
 
 void setMotion(uint16_t value) {
-    room.getMotionDetector()->setValue(value);
+    registry.setMotion(defaultRoom, value);
+}
+
+void setSampleTime(uint32_t timestamp) {
+    registry.setSampleTime(defaultRoom, timestamp);
 }
 
 // Sensor getters
 uint16_t getTemperature(void) {
-    return room.getTemperatureSensor()->readValue();
+    return registry.getTemperature(defaultRoom);
 }
 
 uint16_t getMotion(void) {
-    return room.getMotionDetector()->readValue();
+    return registry.getMotion(defaultRoom);
 }   
 
+uint32_t getSampleTime(void) {
+    return registry.getSampleTime(defaultRoom);
+}
+
+// Whole-room snapshots
+void getSensorSnapshot(RoomSample_t *sample) {
+    registry.readSamples(defaultRoom, 1U, sample);
+}
+
+void setSensorSnapshot(const RoomSample_t *sample) {
+    registry.writeSamples(defaultRoom, 1U, sample);
+}
+
+uint16_t getSensorHistory(uint16_t maxSamples, RoomSample_t *samples, uint32_t *recorded) {
+    return registry.readHistory(defaultRoom, maxSamples, samples, recorded);
+}
+
+uint16_t getSensorBlock(SensorKind_t sensor, uint32_t since, SampleBlock_t *block) {
+    return registry.readBlock(defaultRoom, sensor, since, block);
+}
+
+void setSensorObserver(ChangeObserver_t observer, void *context,
+                       uint16_t temperatureDeadband, uint16_t motionDeadband) {
+    registry.setObserver(observer, context, temperatureDeadband, motionDeadband);
+}
+
 // Device Control
-void turnOnLight(void)   { room.turnOnLight();  }
-void turnOffLight(void)  { room.turnOffLight(); }
-void turnOnAC(void)      { room.turnOnAC();     }
-void turnOffAC(void)     { room.turnOffAC();    }
-void turnOnHeater(void)  { room.turnOnHeater(); }
-void turnOffHeater(void) { room.turnOffHeater();}
\ No newline at end of file
+void turnOnLight(void)   { registry.setLight(defaultRoom, true);   }
+void turnOffLight(void)  { registry.setLight(defaultRoom, false);  }
+void turnOnAC(void)      { registry.setAC(defaultRoom, true);      }
+void turnOffAC(void)     { registry.setAC(defaultRoom, false);     }
+void turnOnHeater(void)  { registry.setHeater(defaultRoom, true);  }
+void turnOffHeater(void) { registry.setHeater(defaultRoom, false); }
+
+// Room management
+uint16_t addRoom(uint16_t roomNumber)   { return registry.addRoom(roomNumber);  }
+uint16_t findRoom(uint16_t roomNumber)  { return registry.findRoom(roomNumber); }
+uint16_t getRoomCount(void)             { return registry.getRoomCount();       }
+uint16_t getRoomNumber(uint16_t index)  { return registry.getRoomNumber(index); }
+
+// Building topology
+const RoomTopology_t *getTopology(void)                 { return registry.getTopology(defaultRoom); }
+const RoomTopology_t *getRoomTopology(uint16_t index)   { return registry.getTopology(index);       }
+
+// Per-room sensors
+void setRoomTemperature(uint16_t index, uint16_t value)   { registry.setTemperature(index, value);    }
+void setRoomMotion(uint16_t index, uint16_t value)        { registry.setMotion(index, value);         }
+void setRoomSampleTime(uint16_t index, uint32_t timestamp){ registry.setSampleTime(index, timestamp); }
+uint16_t getRoomTemperature(uint16_t index)               { return registry.getTemperature(index);    }
+uint16_t getRoomMotion(uint16_t index)                    { return registry.getMotion(index);         }
+uint32_t getRoomSampleTime(uint16_t index)                { return registry.getSampleTime(index);     }
+
+uint16_t getRoomSnapshots(uint16_t first, uint16_t count, RoomSample_t *samples) {
+    return registry.readSamples(first, count, samples);
+}
+
+uint16_t setRoomSnapshots(uint16_t first, uint16_t count, const RoomSample_t *samples) {
+    return registry.writeSamples(first, count, samples);
+}
+
+uint16_t getRoomHistory(uint16_t index, uint16_t maxSamples, RoomSample_t *samples, uint32_t *recorded) {
+    return registry.readHistory(index, maxSamples, samples, recorded);
+}
+
+uint16_t getRoomBlock(uint16_t index, SensorKind_t sensor, uint32_t since, SampleBlock_t *block) {
+    return registry.readBlock(index, sensor, since, block);
+}
+
+// Per-room devices
+void setRoomLight(uint16_t index, bool on)  { registry.setLight(index, on);      }
+void setRoomAC(uint16_t index, bool on)     { registry.setAC(index, on);         }
+void setRoomHeater(uint16_t index, bool on) { registry.setHeater(index, on);     }
+bool getRoomLight(uint16_t index)           { return registry.getLight(index);   }
+bool getRoomAC(uint16_t index)              { return registry.getAC(index);      }
+bool getRoomHeater(uint16_t index)          { return registry.getHeater(index);  }
+
+// Device deltas
+uint16_t takeDeviceChanges(DeviceChange_t *changes, uint16_t maxChanges) {
+    return registry.takeDeviceChanges(changes, maxChanges);
+}
+
+void markAllDevicesDirty(void) {
+    registry.markAllDevicesDirty();
+}
+
+// All rooms
+const uint16_t *getRoomTemperatures(void) {
+    return registry.temperatures();
+}
+
+void controlAllRooms(uint16_t acAbove, uint16_t heaterBelow) {
+    registry.controlAll(acAbove, heaterBelow);
+}
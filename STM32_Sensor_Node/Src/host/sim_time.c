@@ -0,0 +1,28 @@
+/**
+ * @file sim_time.c
+ * @brief Virtual-time tick suppression for the host simulation (SIM_VIRTUAL_TIME).
+ * 
+ * FreeRTOSConfig.h routes portSUPPRESS_TICKS_AND_SLEEP() here. The idle task calls it
+ * with the scheduler suspended when no task is ready, passing the number of ticks
+ * until the next task unblocks. Instead of sleeping, the tick count is stepped over
+ * that gap, so a 10 s vTaskDelay() costs no wall-clock time and a simulated day of
+ * operation runs in seconds. Ticks that elapse while tasks are running still come
+ * from the port's real-time tick.
+*/
+
+#if defined(SIM_VIRTUAL_TIME)
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief Skip the idle period instead of sleeping through it.
+ * @param xExpectedIdleTime  Ticks until the next task is due to unblock.
+*/
+void vSimSuppressTicksAndSleep(unsigned long xExpectedIdleTime)
+{
+    // vTaskStepTick() handles a jump that lands exactly on the next unblock time
+    vTaskStepTick((TickType_t)xExpectedIdleTime);
+}
+
+#endif /* SIM_VIRTUAL_TIME */
@@ -0,0 +1,119 @@
+/**
+ * @file uart_host.c
+ * @brief UART backend for the host (POSIX) build.
+ * 
+ * Replaces uart.c when building with `make host`.
+ * UART2 (debug logging) is mapped to stdout.
+ * UART1 (ESP32 communication) is mapped to a pseudo-terminal whose slave path is
+ * logged at startup, so the ESP32 gateway or a terminal program can attach to it.
+*/
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <termios.h>
+
+#include "uart.h"
+
+static int uart1_fd       = -1;		// Master side of the UART1 pseudo-terminal
+static int uart1_slave_fd = -1;		// Slave side, held open so writes never fail with EIO
+
+/**
+ * @brief Initialize UART1 backend.
+ * 
+ * Opens a pseudo-terminal in raw mode (no echo, no line discipline) to stand
+ * in for the ESP32 link.
+*/
+void uart1_init(void) 
+{
+	struct termios tio;
+
+	uart1_fd = posix_openpt(O_RDWR | O_NOCTTY);
+	if (uart1_fd < 0 || grantpt(uart1_fd) != 0 || unlockpt(uart1_fd) != 0) {
+		perror("uart1_init");
+		return;
+	}
+
+	uart1_slave_fd = open(ptsname(uart1_fd), O_RDWR | O_NOCTTY);
+	if (uart1_slave_fd >= 0 && tcgetattr(uart1_slave_fd, &tio) == 0) {
+		cfmakeraw(&tio);
+		tcsetattr(uart1_slave_fd, TCSANOW, &tio);
+	}
+
+#if defined(SIM_VIRTUAL_TIME)
+	// A simulated day outruns any reader: drop bytes once the pty is full instead of
+	// stalling the scheduler in write(), as a real UART with nothing attached would.
+	fcntl(uart1_fd, F_SETFL, fcntl(uart1_fd, F_GETFL) | O_NONBLOCK);
+#endif
+
+	LOG("UART1 (ESP32 link) on %s", ptsname(uart1_fd));
+}
+
+/**
+ * @brief Transmit a null-terminated string over UART1.
+ * @param str Pointer to a null-terminated string to transmit.
+*/
+void uart1_write_string(const char *str) 
+{
+	if(str == NULL) return;
+
+    while (*str != '\0') 
+	{
+        uart1_write((int)*str);
+        str++;
+    }
+    uart1_write('\n');  // Terminator the ESP32 can detect
+}
+
+/**
+ * @brief Transmit a single byte over UART1.
+ * @param ch  Byte to transmit.
+*/
+void uart1_write(int ch) 
+{
+	unsigned char byte = (unsigned char)(ch & 0xFF);
+
+	if (uart1_fd < 0) return;
+	while (write(uart1_fd, &byte, 1) < 0 && errno == EINTR) {};
+}
+
+/**
+ * @brief Receive a single character from UART1.
+ * Blocks until a character is available.
+ * @return Received byte, or 0 if the link is closed.
+*/
+char uart1_read(void) 
+{
+	char ch = 0;
+	ssize_t ret;
+
+	if (uart1_fd < 0) return 0;
+	do {
+		ret = read(uart1_fd, &ch, 1);
+	} while (ret < 0 && errno == EINTR);
+
+	return (ret == 1) ? ch : 0;
+}
+
+/**
+ * @brief Initialize UART2 backend.
+ * 
+ * Line-buffers stdout so log lines appear promptly when piped to a file.
+*/
+void uart2_init(void) 
+{
+	setvbuf(stdout, NULL, _IOLBF, 0);
+}
+
+/**
+ * @brief Transmit a single character over UART2 (stdout).
+ * @param ch  Character to transmit.
+*/
+void uart2_write(int ch) 
+{
+	putchar(ch);
+}
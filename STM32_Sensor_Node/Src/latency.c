@@ -0,0 +1,166 @@
+/**
+ * @file latency.c
+ * @brief Per-stage sample latency histograms for the sensor pipeline.
+ * 
+ * Each stage has exactly one writer (the task that receives the sample), so
+ * latency_record() takes no lock. Readers copy a stage inside a critical section.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "latency.h"
+#include "rstats.h"
+#include "shared_resources.h"
+
+typedef struct {
+    uint32_t buckets[LATENCY_HIST_BUCKETS];
+    uint32_t count;
+    uint32_t max;
+} LatencyHist_t;
+
+static LatencyHist_t histograms[LATENCY_STAGE_COUNT];
+
+static const char *const stage_names[LATENCY_STAGE_COUNT] = {
+    "Write->Read",
+    "Read->Ctrl",
+    "Ctrl->Tx",
+    "End-to-end",
+};
+
+// Local function prototypes
+static uint32_t bucket_index(uint32_t ticks);
+static uint32_t bucket_upper_bound(uint32_t index);
+static uint32_t percentile(const LatencyHist_t *hist, uint32_t percent);
+
+/**
+ * @brief Record the latency of one sample at the given stage.
+ * 
+ * Must only be called by the task that owns the stage.
+ * 
+ * @param stage  Pipeline hop being measured.
+ * @param ticks  Age of the sample at this hop, in ticks.
+*/
+void latency_record(LatencyStage_t stage, TickType_t ticks)
+{
+    LatencyHist_t *hist;
+
+    if (stage >= LATENCY_STAGE_COUNT) {
+        return;
+    }
+
+    hist = &histograms[stage];
+    hist->buckets[bucket_index((uint32_t)ticks)]++;
+    hist->count++;
+    if ((uint32_t)ticks > hist->max) {
+        hist->max = (uint32_t)ticks;
+    }
+}
+
+/**
+ * @brief Get count, p50, p99 and max of one stage.
+ * 
+ * @param stage    Pipeline hop to summarize.
+ * @param summary  Output summary, in ticks.
+*/
+void latency_get_summary(LatencyStage_t stage, LatencySummary_t *summary)
+{
+    LatencyHist_t snapshot;
+
+    if (stage >= LATENCY_STAGE_COUNT || summary == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    snapshot = histograms[stage];
+    taskEXIT_CRITICAL();
+
+    summary->count = snapshot.count;
+    summary->p50   = percentile(&snapshot, 50U);
+    summary->p99   = percentile(&snapshot, 99U);
+    summary->max   = snapshot.max;
+}
+
+/** @brief Clear all histograms */
+void latency_reset(void)
+{
+    taskENTER_CRITICAL();
+    memset(histograms, 0, sizeof(histograms));
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Send one summary line per stage to the Logger Queue.
+ * 
+ * Can be called from any task; lines that do not fit in the queue are dropped.
+*/
+void latency_dump(void)
+{
+    char msg[LOG_MSG_MAX_LEN];
+    LatencySummary_t summary;
+    BaseType_t xRet = pdFALSE;
+
+    for (uint32_t stage = 0U; stage < (uint32_t)LATENCY_STAGE_COUNT; stage++) {
+        latency_get_summary((LatencyStage_t)stage, &summary);
+        snprintf(msg, sizeof(msg), "[%-12s] %-11s n: %lu  p50: <=%lu  p99: <=%lu  max: %lu ticks",
+                 "Latency", stage_names[stage],
+                 (unsigned long)summary.count, (unsigned long)summary.p50,
+                 (unsigned long)summary.p99, (unsigned long)summary.max);
+        xRet = xQueueSend(xLogQueue, msg, 0U);
+        rstats_record_send(RSTATS_LOG_QUEUE, xRet);
+    }
+}
+
+/** @brief Map a latency to its power-of-two bucket */
+static uint32_t bucket_index(uint32_t ticks)
+{
+    uint32_t index = 0U;
+
+    while (ticks != 0U && index < (LATENCY_HIST_BUCKETS - 1U)) {
+        ticks >>= 1;
+        index++;
+    }
+    return index;
+}
+
+/** @brief Largest latency that falls into a bucket (the last bucket is open-ended) */
+static uint32_t bucket_upper_bound(uint32_t index)
+{
+    if (index == 0U) {
+        return 0U;
+    }
+    if (index == (LATENCY_HIST_BUCKETS - 1U)) {
+        return UINT32_MAX;
+    }
+    return (1UL << index) - 1U;
+}
+
+/**
+ * @brief Walk the histogram to the bucket holding the given percentile.
+ * @return Upper bound of that bucket, capped at the recorded maximum.
+*/
+static uint32_t percentile(const LatencyHist_t *hist, uint32_t percent)
+{
+    uint32_t target;
+    uint32_t seen = 0U;
+    uint32_t bound;
+
+    if (hist->count == 0U) {
+        return 0U;
+    }
+
+    target = (uint32_t)(((uint64_t)hist->count * percent + 99U) / 100U);
+    for (uint32_t i = 0U; i < LATENCY_HIST_BUCKETS; i++) {
+        seen += hist->buckets[i];
+        if (seen >= target) {
+            bound = bucket_upper_bound(i);
+            return (bound < hist->max) ? bound : hist->max;
+        }
+    }
+    return hist->max;
+}
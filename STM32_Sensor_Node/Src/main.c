@@ -8,26 +8,27 @@
 
 #include <stdint.h>
 
+#if defined(HOST_BUILD)
+#include <stdio.h>
+#include <stdlib.h>
+#else
 #include "stm32f446xx.h"
+#endif
 
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
-#include "semphr.h"
 #include "stream_buffer.h"
 
 #include "uart.h"
+#include "tasks.h"
+#include "soak_monitor.h"
+#include "profile.h"
 #include "shared_resources.h"
-#include "task_logger.h"
-#include "task_transmit.h"
-#include "task_controller.h"
-#include "task_sensor_write.h"
-#include "task_sensor_read.h"
 
 #define STACK_SIZE_WORDS       (1024U)
 
 // Global resource handles
-SemaphoreHandle_t    xSensorMutex      = NULL;
 QueueHandle_t        xLogQueue         = NULL;
 QueueHandle_t        xSensorQueue      = NULL;
 StreamBufferHandle_t xStreamBuffer     = NULL;
@@ -47,6 +48,19 @@ void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName) {
     while(1) {}
 }
 
+#if defined(HOST_BUILD)
+/**
+ * @brief configASSERT() handler for the host build.
+ * 
+ * Reports the failing location and aborts so a regression run fails visibly
+ * instead of spinning forever.
+*/
+void vAssertCalled(const char *pcFile, unsigned long ulLine) {
+    fprintf(stderr, "ASSERT failed: %s:%lu\n", pcFile, ulLine);
+    abort();
+}
+#endif
+
 /**
  * @brief Application entry point.
  * 
@@ -62,19 +76,18 @@ int main(void)
 
     check_reset_cause();        // Log the cause of the last reset
 
+    PROFILE_INIT();             // Start the cycle counter (no-op unless PROFILE_ENABLED)
+
     LOG("*** STM32 Sensor Node Starting ***");
 
     // Create synchronization primitives
-    xSensorMutex = xSemaphoreCreateMutex();
-    configASSERT(xSensorMutex != NULL);
-
     xLogQueue = xQueueCreate(LOG_QUEUE_DEPTH, LOG_MSG_MAX_LEN);
     configASSERT(xLogQueue != NULL);
 
-    xSensorQueue = xQueueCreate(SENSOR_QUEUE_DEPTH, sizeof(SensorData_t));
+    xSensorQueue = xQueueCreate(SENSOR_QUEUE_DEPTH, sizeof(SampleRecord_t *));
     configASSERT(xSensorQueue != NULL);
 
-    xStreamBuffer = xStreamBufferCreate(STREAM_BUFFER_SIZE, sizeof(TransmitData_t));
+    xStreamBuffer = xStreamBufferCreate(STREAM_BUFFER_SIZE, sizeof(SampleRecord_t *));
     configASSERT(xStreamBuffer != NULL);
 
     // Create tasks
@@ -88,8 +101,12 @@ int main(void)
     configASSERT(xRet == pdPASS);
     xRet = xTaskCreate(vTaskLogger,      "Logger",      STACK_SIZE_WORDS, NULL, 1, NULL);
     configASSERT(xRet == pdPASS);
+#if defined(SOAK_MONITOR)
+    xRet = xTaskCreate(vTaskSoakMonitor, "SoakMonitor", STACK_SIZE_WORDS, NULL, 1, NULL);
+    configASSERT(xRet == pdPASS);
+#endif
 
-    LOG("Tasks created. Free heap: %u bytes", xPortGetFreeHeapSize());
+    LOG("Tasks created. Free heap: %u bytes", (unsigned int)xPortGetFreeHeapSize());
     LOG("Starting scheduler...");
 
     vTaskStartScheduler();  
@@ -105,6 +122,9 @@ int main(void)
 */
 static void check_reset_cause(void) 
 {
+#if defined(HOST_BUILD)
+    LOG("Reset: Host process start");
+#else
     uint32_t cause = RCC->CSR;
     RCC->CSR |= RCC_CSR_RMVF;           // Clear reset flags
 
@@ -112,4 +132,5 @@ static void check_reset_cause(void)
     if (cause & RCC_CSR_SFTRSTF)  { LOG("Reset: Software"); }
     if (cause & RCC_CSR_PORRSTF)  { LOG("Reset: Power-On"); }
     if (cause & RCC_CSR_PINRSTF)  { LOG("Reset: External Pin"); }
+#endif
 }
\ No newline at end of file
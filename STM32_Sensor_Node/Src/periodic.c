@@ -0,0 +1,169 @@
+/**
+ * @file periodic.c
+ * @brief Drift-free periodic wake-ups with jitter and missed-deadline counters.
+ *
+ * Each task owns its schedule and its counters, so updates take no lock. Readers
+ * copy the counters of a task inside a critical section.
+*/
+
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "periodic.h"
+
+typedef struct {
+    TickType_t      xLastWake;      // Latest deadline (or schedule start)
+    PeriodicStats_t stats;
+} PeriodicSchedule_t;
+
+static PeriodicSchedule_t schedules[PERIODIC_TASK_COUNT];
+
+static const char *const task_names[PERIODIC_TASK_COUNT] = {
+    "SensorWrite",
+    "SensorRead",
+};
+
+// Local function prototypes
+static void check_deadline(PeriodicSchedule_t *schedule, TickType_t xNow, TickType_t xPeriod);
+static void record_wakeup(PeriodicSchedule_t *schedule, TickType_t xDeadline);
+
+/**
+ * @brief Start the schedule of the calling task at the current tick.
+ *
+ * The first deadline is one period from now.
+*/
+void periodic_start(PeriodicTask_t task)
+{
+    if (task >= PERIODIC_TASK_COUNT) {
+        return;
+    }
+
+    schedules[task].xLastWake = xTaskGetTickCount();
+}
+
+/**
+ * @brief Sleep until the next deadline, one period after the previous one.
+ *
+ * Must only be called by the task that owns the schedule. The period may change
+ * from one call to the next (e.g. burst gaps of the sample source).
+ *
+ * @param task     Schedule of the calling task.
+ * @param xPeriod  Ticks from the previous deadline to the next one.
+ * @return pdTRUE if the deadline was met, pdFALSE if it had already passed and the
+ *         schedule restarted from the current tick.
+*/
+BaseType_t periodic_wait(PeriodicTask_t task, TickType_t xPeriod)
+{
+    PeriodicSchedule_t *schedule;
+    uint32_t ulMissed;
+
+    if (task >= PERIODIC_TASK_COUNT) {
+        vTaskDelay(xPeriod);
+        return pdTRUE;
+    }
+
+    schedule = &schedules[task];
+    ulMissed = schedule->stats.missed;
+    check_deadline(schedule, xTaskGetTickCount(), xPeriod);
+
+    (void)xTaskDelayUntil(&schedule->xLastWake, xPeriod);
+    record_wakeup(schedule, schedule->xLastWake);
+
+    return (schedule->stats.missed == ulMissed) ? pdTRUE : pdFALSE;
+}
+
+/**
+ * @brief Sleep until a direct-to-task notification arrives or the next deadline.
+ *
+ * A deadline wake-up advances the schedule by exactly one period. A notification
+ * restarts the schedule from the current tick, so the periodic wake-up only comes
+ * after a full period without notifications; it is counted as notified, with no
+ * jitter.
+ *
+ * @param task     Schedule of the calling task.
+ * @param xPeriod  Ticks from the previous deadline to the next one.
+ * @return Notification count taken (cleared), 0 if the deadline was reached.
+*/
+uint32_t periodic_wait_notify(PeriodicTask_t task, TickType_t xPeriod)
+{
+    PeriodicSchedule_t *schedule;
+    TickType_t xNow;
+    TickType_t xDeadline;
+    uint32_t   ulNotified;
+
+    if (task >= PERIODIC_TASK_COUNT) {
+        return ulTaskNotifyTake(pdTRUE, xPeriod);
+    }
+
+    schedule = &schedules[task];
+    xNow = xTaskGetTickCount();
+    check_deadline(schedule, xNow, xPeriod);
+
+    xDeadline  = schedule->xLastWake + xPeriod;
+    ulNotified = ulTaskNotifyTake(pdTRUE, xDeadline - xNow);
+
+    if (ulNotified == 0U) {
+        schedule->xLastWake = xDeadline;
+        record_wakeup(schedule, xDeadline);
+    } else {
+        schedule->xLastWake = xTaskGetTickCount();
+        schedule->stats.notified++;
+    }
+    return ulNotified;
+}
+
+/** @brief Copy the counters of one task */
+void periodic_get(PeriodicTask_t task, PeriodicStats_t *stats)
+{
+    if (task >= PERIODIC_TASK_COUNT || stats == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = schedules[task].stats;
+    taskEXIT_CRITICAL();
+}
+
+const char *periodic_name(PeriodicTask_t task)
+{
+    return (task < PERIODIC_TASK_COUNT) ? task_names[task] : "?";
+}
+
+/** @brief Clear all counters; the schedules themselves keep running */
+void periodic_reset(void)
+{
+    taskENTER_CRITICAL();
+    for (uint32_t task = 0U; task < (uint32_t)PERIODIC_TASK_COUNT; task++) {
+        memset(&schedules[task].stats, 0, sizeof(schedules[task].stats));
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Count a deadline that passed while the task was working.
+ *
+ * The schedule restarts from xNow rather than catching up with back-to-back periods.
+*/
+static void check_deadline(PeriodicSchedule_t *schedule, TickType_t xNow, TickType_t xPeriod)
+{
+    if ((TickType_t)(xNow - schedule->xLastWake) > xPeriod) {
+        schedule->stats.missed++;
+        schedule->xLastWake = xNow;
+    }
+}
+
+/** @brief Record the lateness of a wake-up against its deadline */
+static void record_wakeup(PeriodicSchedule_t *schedule, TickType_t xDeadline)
+{
+    uint32_t ulJitter = (uint32_t)(TickType_t)(xTaskGetTickCount() - xDeadline);
+
+    schedule->stats.wakeups++;
+    schedule->stats.lastJitter   = ulJitter;
+    schedule->stats.totalJitter += ulJitter;
+    if (ulJitter > schedule->stats.maxJitter) {
+        schedule->stats.maxJitter = ulJitter;
+    }
+}
@@ -0,0 +1,127 @@
+/**
+ * @file profile.c
+ * @brief Cycle-counter profiling with scoped timers and named probes.
+ * 
+ * Probes are hit from several tasks (LOG_* formatting, the Logger, the controller),
+ * so each record is made inside a short critical section.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "profile.h"
+#include "rstats.h"
+#include "shared_resources.h"
+
+static ProfileStats_t probes[PROFILE_PROBE_COUNT];
+
+static const char *const probe_names[PROFILE_PROBE_COUNT] = {
+    "control_devices",
+    "log_messages",
+    "LOG_* format",
+    "uart2 write",
+};
+
+/**
+ * @brief Start the time base.
+ * 
+ * Enables the DWT cycle counter on the STM32; nothing to do on the host.
+ * Call once from main() before the scheduler starts.
+*/
+void profile_init(void)
+{
+#if !defined(HOST_BUILD)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;     // Enable the DWT unit
+    DWT->CYCCNT = 0U;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;               // Start the cycle counter
+#endif
+    profile_reset();
+}
+
+/**
+ * @brief Add one timed call to a probe.
+ * 
+ * @param probe    Probe to update.
+ * @param elapsed  Duration of the call, in PROFILE_UNIT.
+*/
+void profile_record(ProfileProbe_t probe, uint32_t elapsed)
+{
+    ProfileStats_t *stats;
+
+    if (probe >= PROFILE_PROBE_COUNT) {
+        return;
+    }
+
+    stats = &probes[probe];
+
+    taskENTER_CRITICAL();
+    if (stats->calls == 0U || elapsed < stats->min) {
+        stats->min = elapsed;
+    }
+    if (elapsed > stats->max) {
+        stats->max = elapsed;
+    }
+    stats->calls++;
+    stats->total += elapsed;
+    taskEXIT_CRITICAL();
+}
+
+/** @brief Copy the statistics of one probe */
+void profile_get(ProfileProbe_t probe, ProfileStats_t *out)
+{
+    if (probe >= PROFILE_PROBE_COUNT || out == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    *out = probes[probe];
+    taskEXIT_CRITICAL();
+}
+
+const char *profile_name(ProfileProbe_t probe)
+{
+    return (probe < PROFILE_PROBE_COUNT) ? probe_names[probe] : "?";
+}
+
+/** @brief Clear all probes */
+void profile_reset(void)
+{
+    taskENTER_CRITICAL();
+    memset(probes, 0, sizeof(probes));
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Send one line per probe to the Logger Queue, which prints it on UART2.
+ * 
+ * Besides the per-call average, each line gives the probe's total cost per sample,
+ * taking the control_devices() call count as the number of samples. The controller
+ * decides once per batch, so when samples queue up this is the cost per batch.
+ * Lines that do not fit in the queue are dropped.
+*/
+void profile_dump(void)
+{
+    char msg[LOG_MSG_MAX_LEN];
+    ProfileStats_t stats;
+    uint32_t samples;
+    BaseType_t xRet = pdFALSE;
+
+    profile_get(PROFILE_CONTROL_DEVICES, &stats);
+    samples = stats.calls;
+
+    for (uint32_t probe = 0U; probe < (uint32_t)PROFILE_PROBE_COUNT; probe++) {
+        profile_get((ProfileProbe_t)probe, &stats);
+        snprintf(msg, sizeof(msg), "[%-12s] %-15s n: %lu  avg: %lu  min: %lu  max: %lu  per sample: %lu %s",
+                 "Profile", probe_names[probe], (unsigned long)stats.calls,
+                 (unsigned long)((stats.calls > 0U) ? stats.total / stats.calls : 0U),
+                 (unsigned long)stats.min, (unsigned long)stats.max,
+                 (unsigned long)((samples > 0U) ? stats.total / samples : 0U), PROFILE_UNIT);
+        xRet = xQueueSend(xLogQueue, msg, 0U);
+        rstats_record_send(RSTATS_LOG_QUEUE, xRet);
+    }
+}
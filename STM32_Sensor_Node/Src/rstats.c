@@ -0,0 +1,159 @@
+/**
+ * @file rstats.c
+ * @brief Usage counters for the shared IPC resources.
+ * 
+ * Counters are shared by every task that sends to a resource, so updates are made
+ * inside a short critical section.
+*/
+
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+
+#include "rstats.h"
+#include "sample_pool.h"
+#include "shared_resources.h"
+
+static RStats_t   stats[RSTATS_RESOURCE_COUNT];
+static BaseType_t dropping[RSTATS_RESOURCE_COUNT];      // pdTRUE while the latest send was dropped
+
+static const char *const resource_names[RSTATS_RESOURCE_COUNT] = {
+    "LogQueue",
+    "SensorQueue",
+    "StreamBuffer",
+    "SamplePool",
+};
+
+// Local function prototypes
+static uint32_t resource_level(RStatsResource_t resource);
+static uint32_t resource_capacity(RStatsResource_t resource);
+
+/**
+ * @brief Account for one send attempt.
+ * 
+ * @param resource  Resource that was sent to.
+ * @param xSent     pdTRUE if the item was accepted, pdFALSE if it was dropped.
+*/
+void rstats_record_send(RStatsResource_t resource, BaseType_t xSent)
+{
+    uint32_t level;
+
+    if (resource >= RSTATS_RESOURCE_COUNT) {
+        return;
+    }
+
+    level = (xSent == pdTRUE) ? resource_level(resource) : 0U;
+
+    taskENTER_CRITICAL();
+    if (xSent == pdTRUE) {
+        stats[resource].sent++;
+        if (level > stats[resource].highWater) {
+            stats[resource].highWater = level;
+        }
+    } else {
+        stats[resource].dropped++;
+        if (dropping[resource] == pdFALSE) {
+            stats[resource].fullEvents++;
+        }
+    }
+    dropping[resource] = (xSent == pdTRUE) ? pdFALSE : pdTRUE;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Account for one send that carried several items.
+ * 
+ * @param resource   Resource that was sent to.
+ * @param ulSent     Items accepted.
+ * @param ulDropped  Items that did not fit and were dropped.
+*/
+void rstats_record_batch(RStatsResource_t resource, uint32_t ulSent, uint32_t ulDropped)
+{
+    uint32_t level;
+
+    if (resource >= RSTATS_RESOURCE_COUNT) {
+        return;
+    }
+
+    level = (ulSent > 0U) ? resource_level(resource) : 0U;
+
+    taskENTER_CRITICAL();
+    stats[resource].sent    += ulSent;
+    stats[resource].dropped += ulDropped;
+    if (level > stats[resource].highWater) {
+        stats[resource].highWater = level;
+    }
+    if (ulDropped > 0U && (ulSent > 0U || dropping[resource] == pdFALSE)) {
+        stats[resource].fullEvents++;           // Accepted items first: the resource filled up in this send
+    }
+    dropping[resource] = (ulDropped > 0U) ? pdTRUE : pdFALSE;
+    taskEXIT_CRITICAL();
+}
+
+/** @brief Copy the counters of one resource */
+void rstats_get(RStatsResource_t resource, RStats_t *out)
+{
+    if (resource >= RSTATS_RESOURCE_COUNT || out == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    *out = stats[resource];
+    taskEXIT_CRITICAL();
+
+    out->capacity = resource_capacity(resource);
+}
+
+const char *rstats_name(RStatsResource_t resource)
+{
+    return (resource < RSTATS_RESOURCE_COUNT) ? resource_names[resource] : "?";
+}
+
+/** @brief Current fill level of a resource, in percent of its capacity */
+uint32_t rstats_fill_pct(RStatsResource_t resource)
+{
+    uint32_t capacity;
+
+    if (resource >= RSTATS_RESOURCE_COUNT) {
+        return 0U;
+    }
+
+    capacity = resource_capacity(resource);
+    return (capacity > 0U) ? (resource_level(resource) * 100U) / capacity : 0U;
+}
+
+/** @brief Clear all counters */
+void rstats_reset(void)
+{
+    taskENTER_CRITICAL();
+    memset(stats, 0, sizeof(stats));
+    memset(dropping, 0, sizeof(dropping));
+    taskEXIT_CRITICAL();
+}
+
+/** @brief Current fill level: items for queues and the pool, bytes for the stream buffer */
+static uint32_t resource_level(RStatsResource_t resource)
+{
+    switch (resource) {
+    case RSTATS_LOG_QUEUE:      return (uint32_t)uxQueueMessagesWaiting(xLogQueue);
+    case RSTATS_SENSOR_QUEUE:   return (uint32_t)uxQueueMessagesWaiting(xSensorQueue);
+    case RSTATS_STREAM_BUFFER:  return (uint32_t)xStreamBufferBytesAvailable(xStreamBuffer);
+    case RSTATS_SAMPLE_POOL:    return sample_pool_in_use();
+    default:                    return 0U;
+    }
+}
+
+static uint32_t resource_capacity(RStatsResource_t resource)
+{
+    switch (resource) {
+    case RSTATS_LOG_QUEUE:      return LOG_QUEUE_DEPTH;
+    case RSTATS_SENSOR_QUEUE:   return SENSOR_QUEUE_DEPTH;
+    case RSTATS_STREAM_BUFFER:  return (uint32_t)STREAM_BUFFER_SIZE;
+    case RSTATS_SAMPLE_POOL:    return SAMPLE_POOL_SIZE;
+    default:                    return 0U;
+    }
+}
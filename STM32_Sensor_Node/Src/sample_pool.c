@@ -0,0 +1,71 @@
+/**
+ * @file sample_pool.c
+ * @brief Fixed pool of SampleRecord_t blocks passed by reference between tasks.
+ *
+ * Free records form a stack of slot indices; slots never used yet are taken from a
+ * high-water mark, so the pool starts all zero in .bss and needs no init call.
+ * Records are taken and given by different tasks, so the stack is updated inside
+ * a short critical section.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "sample_pool.h"
+
+static SampleRecord_t records[SAMPLE_POOL_SIZE];
+static uint16_t       freeStack[SAMPLE_POOL_SIZE];     // Indices of given-back records
+static uint32_t       freeCount;                        // Entries in freeStack
+static uint32_t       highWater;                        // Records ever handed out; later slots are unused
+
+/**
+ * @brief Take a free record.
+ * @return The record, now owned by the caller, or NULL if every record is in use.
+*/
+SampleRecord_t *sample_pool_take(void)
+{
+    SampleRecord_t *record = NULL;
+
+    taskENTER_CRITICAL();
+    if (freeCount > 0U) {
+        record = &records[freeStack[--freeCount]];
+    } else if (highWater < SAMPLE_POOL_SIZE) {
+        record = &records[highWater++];
+    }
+    taskEXIT_CRITICAL();
+
+    return record;
+}
+
+/**
+ * @brief Give a record back to the pool; the caller must not use it afterwards.
+ *
+ * @param record Record from sample_pool_take(); NULL is ignored.
+*/
+void sample_pool_give(SampleRecord_t *record)
+{
+    if (record == NULL) {
+        return;
+    }
+    configASSERT(record >= &records[0] && record < &records[SAMPLE_POOL_SIZE]);
+
+    taskENTER_CRITICAL();
+    configASSERT(freeCount < highWater);
+    freeStack[freeCount++] = (uint16_t)(record - records);
+    taskEXIT_CRITICAL();
+}
+
+/** @brief Number of records currently taken */
+uint32_t sample_pool_in_use(void)
+{
+    uint32_t inUse;
+
+    taskENTER_CRITICAL();
+    inUse = highWater - freeCount;
+    taskEXIT_CRITICAL();
+
+    return inUse;
+}
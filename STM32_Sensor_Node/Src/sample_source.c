@@ -0,0 +1,199 @@
+/**
+ * @file sample_source.c
+ * @brief Pluggable sample source (load generator) for vTaskSensorWrite.
+ * 
+ * The configuration may be changed at runtime from any task; generator state
+ * is reset on every sample_source_configure() call.
+*/
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "sample_source.h"
+
+#define SENSOR_TEMP_MAX          (100U)
+#define SENSOR_MOTION_MAX        (2U)
+
+/** @brief Built-in TABLE script: a slow swing through all three climate bands */
+static const SampleValue_t default_table[] = {
+    { 18U, 0U }, { 19U, 0U }, { 21U, 1U }, { 23U, 1U }, { 25U, 1U },
+    { 27U, 1U }, { 29U, 0U }, { 27U, 0U }, { 24U, 1U }, { 20U, 0U },
+};
+
+static SampleSourceConfig_t config = {
+    .mode        = SAMPLE_SOURCE_MODE,
+    .rateMilliHz = SAMPLE_SOURCE_RATE_MHZ,
+    .constant    = { 22U, 0U },
+    .rampMin     = 15U,
+    .rampMax     = 30U,
+    .rampStep    = 1U,
+    .table       = NULL,
+    .tableLength = 0U,
+    .burstLength = 10U,
+    .burstGapMs  = 1000U,
+};
+
+// Generator state
+static uint32_t ulIndex      = 0U;       // Table position or burst position
+static uint16_t usRampValue  = 0U;
+static uint16_t usRampMotion = 0U;
+
+// Local function prototypes
+static void reset_state(void);
+static TickType_t period_ticks(void);
+
+/**
+ * @brief Replace the sample source configuration.
+ * @param newConfig  New mode, rate and mode parameters.
+*/
+void sample_source_configure(const SampleSourceConfig_t *newConfig)
+{
+    if (newConfig == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    config = *newConfig;
+    reset_state();
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Read the current sample source configuration.
+ * @param out  Copy of the active configuration.
+*/
+void sample_source_get_config(SampleSourceConfig_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    *out = config;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Generate the next sample.
+ * @param sample  Output temperature and motion values.
+*/
+void sample_source_next(SampleValue_t *sample)
+{
+    const SampleValue_t *table;
+    uint32_t tableLength;
+    BaseType_t xRandom = pdFALSE;
+
+    taskENTER_CRITICAL();
+    switch (config.mode) {
+        case SAMPLE_SOURCE_CONSTANT:
+            *sample = config.constant;
+            break;
+
+        case SAMPLE_SOURCE_RAMP:
+            if (usRampValue > config.rampMax) {
+                usRampValue = config.rampMin;
+                usRampMotion ^= 1U;
+            } else if (usRampValue < config.rampMin) {
+                usRampValue = config.rampMin;
+            }
+            sample->temperature = usRampValue;
+            sample->motion      = usRampMotion;
+            usRampValue = (uint16_t)(usRampValue + config.rampStep);
+            break;
+
+        case SAMPLE_SOURCE_TABLE:
+            table       = (config.table != NULL) ? config.table : default_table;
+            tableLength = (config.table != NULL) ? config.tableLength
+                                                 : (uint32_t)(sizeof(default_table) / sizeof(default_table[0]));
+            if (tableLength == 0U) {
+                sample->temperature = 0U;
+                sample->motion      = 0U;
+                break;
+            }
+            *sample = table[ulIndex % tableLength];
+            ulIndex = (ulIndex + 1U) % tableLength;
+            break;
+
+        case SAMPLE_SOURCE_BURST:
+        case SAMPLE_SOURCE_RANDOM:
+        default:
+            xRandom = pdTRUE;           // Generated below, outside the critical section
+            break;
+    }
+    taskEXIT_CRITICAL();
+
+    // rand() is a libc call (locked / reentrant), so it must not run with interrupts masked
+    if (xRandom == pdTRUE) {
+        sample->temperature = (uint16_t)(rand() % (int)SENSOR_TEMP_MAX);       // 0-99
+        sample->motion      = (uint16_t)(rand() % (int)SENSOR_MOTION_MAX);     // 0 or 1
+    }
+}
+
+/**
+ * @brief Delay until the next sample is due.
+ * 
+ * Call once after each sample_source_next(). In BURST mode this returns the
+ * nominal period inside a burst and the gap after the last sample of a burst.
+ * 
+ * @return Delay in ticks (at least one).
+*/
+TickType_t sample_source_next_delay(void)
+{
+    TickType_t xDelay;
+
+    taskENTER_CRITICAL();
+    xDelay = period_ticks();
+    if (config.mode == SAMPLE_SOURCE_BURST) {
+        ulIndex++;
+        if (config.burstLength == 0U || ulIndex >= config.burstLength) {
+            ulIndex = 0U;
+            xDelay  = pdMS_TO_TICKS(config.burstGapMs);
+            xDelay  = (xDelay > 0U) ? xDelay : 1U;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xDelay;
+}
+
+/**
+ * @brief Nominal sample period for the configured rate.
+ * 
+ * Used by vTaskSensorRead so it polls the Room at the same rate samples are produced.
+ * 
+ * @return Period in ticks (at least one).
+*/
+TickType_t sample_source_period_ticks(void)
+{
+    TickType_t xPeriod;
+
+    taskENTER_CRITICAL();
+    xPeriod = period_ticks();
+    taskEXIT_CRITICAL();
+
+    return xPeriod;
+}
+
+/** @brief Reset generator state after a configuration change */
+static void reset_state(void)
+{
+    ulIndex      = 0U;
+    usRampValue  = config.rampMin;
+    usRampMotion = 0U;
+}
+
+/** @brief Convert the configured rate to ticks; caller holds the critical section */
+static TickType_t period_ticks(void)
+{
+    uint64_t ticks;
+
+    if (config.rateMilliHz == 0U) {
+        return portMAX_DELAY;
+    }
+
+    ticks = ((uint64_t)configTICK_RATE_HZ * 1000U) / config.rateMilliHz;
+    return (ticks > 0U) ? (TickType_t)ticks : 1U;
+}
@@ -13,22 +13,44 @@
 #include "semphr.h"
 
 #include "wrapper.h"
+#include "latency.h"
+#include "profile.h"
 #include "tasks.h"
+#include "rstats.h"
+#include "sample_pool.h"
 #include "shared_resources.h"
 
+/** @brief Most samples taken from xSensorQueue per wake-up (1: one sample at a time) */
+#ifndef CONTROLLER_BATCH_MAX
+#define CONTROLLER_BATCH_MAX    (8U)
+#endif
+
 // Local function prototype
-static void control_devices(uint16_t temperature, uint16_t motion);
+static void control_devices(const RoomTopology_t *room, uint16_t temperature, uint16_t motion);
+static uint16_t motion_since(uint32_t *pulSeen, uint16_t newest);
+static void append_window(char *msg, size_t size, SampleRecord_t *const *batch, uint32_t count);
 static void log_messages(const char* taskname, const char* message);
 
 /**
  * @brief Controller task entry point.
  * 
  * This task performs the following:
- * 1. Blocks waiting for sensor data struct from Sensor Queue.
- * 2. Makes control decisions based on sensor values (e.g., turn devices on/off).
- * 3. Writes the sensor data along with a timestamp to a stream buffer for the transmission
- *    task to read and transmit.
- * 4. Logs the transmitted sensor data to the Logger Queue.
+ * 1. Blocks waiting for a sample record from Sensor Queue, then drains whatever
+ *    else is already queued (up to CONTROLLER_BATCH_MAX records) without blocking.
+ * 2. Makes control decisions based on the newest sensor values of the batch
+ *    (e.g., turn devices on/off); older samples of the same room are superseded.
+ *    The light also follows motion in any sample the room recorded since the
+ *    previous decision (its sample history), not only in the samples queued.
+ * 3. Stamps the batch's records and writes their pointers to a stream buffer, as one
+ *    contiguous write, handing them to the transmission task. Records that do not
+ *    fit are given back to the sample pool.
+ * 4. Logs the transmitted sensor data to the Logger Queue, with the range of the
+ *    temperature windows the records carry when they hold more than one sample.
+ * 
+ * With one sample per wake-up (the normal case at low sample rates) this is one
+ * decision, one stream buffer write and one log line per sample, as before. When
+ * samples arrive faster than the controller runs, the kernel calls and context
+ * switches are paid once per batch instead of once per sample.
  * 
  * @param pvParameters Unused parameter required by FreeRTOS task signature.
 */
@@ -38,72 +60,108 @@ void vTaskController(void *pvParameters)
 
     char            msg[LOG_MSG_MAX_LEN];
     BaseType_t      xRet          = pdFALSE;
-    SensorData_t    sensorData    = {0U};
-    TransmitData_t  txData        = {0U};
+    SampleRecord_t *batch[CONTROLLER_BATCH_MAX];
+    uint32_t        ulCount       = 0U;
+    uint32_t        ulFit         = 0U;
+    TickType_t      xNow          = 0U;
     size_t          bytesWritten  = 0U;
+    uint32_t        ulSeen        = 0U;                 // Room history samples already decided on
+    const RoomTopology_t *pxRoom  = getTopology();      // Thresholds of the default room, in flash
+
+    configASSERT(pxRoom != NULL);
 
     while (1) 
     {
-        // 1. Block waiting for sensor data struct from Sensor Queue
-        xRet = xQueueReceive(xSensorQueue, &sensorData, portMAX_DELAY);
+        // 1. Block waiting for a sample record from Sensor Queue, then take the backlog
+        xRet = xQueueReceive(xSensorQueue, &batch[0], portMAX_DELAY);
         if (xRet != pdTRUE) {
             continue;
         }
+        ulCount = 1U;
+        while (ulCount < CONTROLLER_BATCH_MAX &&
+               xQueueReceive(xSensorQueue, &batch[ulCount], 0U) == pdTRUE) {
+            ulCount++;
+        }
 
-        // 2. Make control decision - Turn devices on/off based on sensor values
-        control_devices(sensorData.temperature, sensorData.motion);
+        // 2. Make control decision - Turn devices on/off based on the newest sensor values
+        control_devices(pxRoom, batch[ulCount - 1U]->temperature,
+                        motion_since(&ulSeen, batch[ulCount - 1U]->motion));
 
-        // Attach timestamp to transmit data struct
+        // Attach timestamp to the records
         // For simplicity, we'll just log the current tick count as a timestamp
-        txData.temperature = sensorData.temperature;
-        txData.motion      = sensorData.motion;
-        txData.timestamp   = xTaskGetTickCount();           
-
-        // 3. Write to stream buffer for transmission task
-        bytesWritten = xStreamBufferSend(xStreamBuffer, 
-                                         &txData, 
-                                         sizeof(txData), 
-                                         0U);
-        if (bytesWritten != sizeof(txData)) {
-            // Handle stream buffer send error (e.g., buffer full, log error, set flag)
+        xNow = xTaskGetTickCount();
+        for (uint32_t i = 0U; i < ulCount; i++) {
+            latency_record(LATENCY_READ_TO_CONTROLLER, xNow - batch[i]->readAt);
+            batch[i]->timestamp = xNow;
+        }
+
+        // Format the log line now: once sent, the records belong to the transmission task
+        if (ulCount == 1U) {
+            LOG_TRANSMIT_DATA(msg, "Controller", "Send to stream:",
+                              batch[0]->temperature, batch[0]->motion, batch[0]->timestamp);
+        } else {
+            snprintf(msg, sizeof(msg), "[%-12s] %-18s Samples: %lu  Last temp: %3u  Motion: %u  Timestamp: %lu",
+                     "Controller", "Send batch:", (unsigned long)ulCount,
+                     (unsigned int)batch[ulCount - 1U]->temperature,
+                     (unsigned int)batch[ulCount - 1U]->motion, (unsigned long)xNow);
+        }
+        append_window(msg, sizeof(msg), batch, ulCount);
+
+        // 3. Hand the records to the transmission task: whole pointers only, in one send
+        ulFit = (uint32_t)(xStreamBufferSpacesAvailable(xStreamBuffer) / sizeof(SampleRecord_t *));
+        if (ulFit > ulCount) {
+            ulFit = ulCount;
+        }
+        bytesWritten = (ulFit > 0U)
+                     ? xStreamBufferSend(xStreamBuffer, batch, ulFit * sizeof(SampleRecord_t *), 0U)
+                     : 0U;
+        ulFit = (uint32_t)(bytesWritten / sizeof(SampleRecord_t *));
+        for (uint32_t i = ulFit; i < ulCount; i++) {
+            sample_pool_give(batch[i]);             // Not handed off: still ours to return
         }
+        rstats_record_batch(RSTATS_STREAM_BUFFER, ulFit, ulCount - ulFit);
 
         // 4. Log the transmitted sensor data
-        LOG_TRANSMIT_DATA(msg, "Controller", "Send to stream:", txData.temperature, txData.motion, txData.timestamp);
         xRet = xQueueSend(xLogQueue, msg, 0);
-        if (xRet != pdTRUE) {
-            // Log queue is full, handle error as needed (e.g., drop message, set error flag)
-        }
+        rstats_record_send(RSTATS_LOG_QUEUE, xRet);
     }
 }
 
 /**
  * @brief Control devices based on sensor readings.
  * 
- * This function implements simple control logic:
- *  - If temperature > 25C, turn on AC and turn off heater.
- *  - If temperature < 20C, turn on heater and turn off AC.
- *  - If 20C <= temperature <= 25C, turn off both AC and heater.
+ * This function implements simple control logic, with the room's thresholds
+ * from the building topology (25C and 20C for room 101):
+ *  - If temperature > acAbove, turn on AC and turn off heater.
+ *  - If temperature < heaterBelow, turn on heater and turn off AC.
+ *  - Otherwise, turn off both AC and heater.
  *  - If motion is detected, turn on light; otherwise, turn off light.
  * 
+ * @param room Topology entry of the room.
  * @param temperature Current temperature reading from the sensor.
  * @param motion Current motion reading from the sensor (0 or 1).
 */
-static void control_devices(uint16_t temperature, uint16_t motion) 
+static void control_devices(const RoomTopology_t *room, uint16_t temperature, uint16_t motion) 
 {
-    if (temperature > 25U) {
+    PROFILE_SCOPE(PROFILE_CONTROL_DEVICES);
+
+    char action[48];
+
+    if (temperature > room->acAbove) {
         turnOnAC();
         turnOffHeater();
-        log_messages("Controller", "T > 25C : AC on, Heater off");
-    } else if (temperature < 20U) {
+        snprintf(action, sizeof(action), "T > %uC : AC on, Heater off", (unsigned int)room->acAbove);
+    } else if (temperature < room->heaterBelow) {
         turnOnHeater();
         turnOffAC();
-        log_messages("Controller", "T < 20C : Heater on, AC off");
+        snprintf(action, sizeof(action), "T < %uC : Heater on, AC off", (unsigned int)room->heaterBelow);
     } else {
         turnOffAC();
         turnOffHeater();
-        log_messages("Controller", "20C <= T <= 25C : AC off, Heater off");
+        snprintf(action, sizeof(action), "%uC <= T <= %uC : AC off, Heater off",
+                 (unsigned int)room->heaterBelow, (unsigned int)room->acAbove);
     }
+    log_messages("Controller", action);
 
     if (motion > 0U) {
         turnOnLight();
@@ -114,6 +172,63 @@ static void control_devices(uint16_t temperature, uint16_t motion)
     }
 }
 
+/**
+ * @brief Motion in any sample of the default room recorded since the previous call.
+ * 
+ * vTaskSensorRead only reads the room on a change past the deadband or on its
+ * heartbeat, so a short motion between two reads never reaches the queue. The
+ * room's sample history holds every sample vTaskSensorWrite published; all those
+ * recorded since the last call are checked (the newest ROOM_HISTORY_DEPTH if more).
+ * 
+ * @param pulSeen Samples recorded as of the previous call, updated.
+ * @param newest  Motion of the newest queued sample, used if no sample shows motion.
+ * @return The first non-zero motion since the previous call, or newest.
+*/
+static uint16_t motion_since(uint32_t *pulSeen, uint16_t newest)
+{
+    RoomSample_t history[ROOM_HISTORY_SLOTS];
+    uint32_t     ulRecorded = 0U;
+    uint16_t     usCount    = getSensorHistory(ROOM_HISTORY_DEPTH, history, &ulRecorded);
+    uint32_t     ulNew      = ulRecorded - *pulSeen;
+
+    *pulSeen = ulRecorded;
+    for (uint16_t i = (ulNew < usCount) ? (uint16_t)(usCount - ulNew) : 0U; i < usCount; i++) {
+        if (history[i].motion > 0U) {
+            return history[i].motion;
+        }
+    }
+    return newest;
+}
+
+/**
+ * @brief Append the temperature range of the batch's sample windows to a log line.
+ * 
+ * Each record's window holds the temperature samples recorded since the one before
+ * it, so together they cover every sample since the previous batch, also those
+ * vTaskSensorRead did not read on its own. The blocks are read in place. Nothing is
+ * appended when the windows hold one sample or none, as the line already shows it.
+*/
+static void append_window(char *msg, size_t size, SampleRecord_t *const *batch, uint32_t count)
+{
+    uint32_t ulSamples = 0U;
+    uint16_t usMin     = UINT16_MAX;
+    uint16_t usMax     = 0U;
+    size_t   len       = strlen(msg);
+
+    for (uint32_t r = 0U; r < count; r++) {
+        const SampleBlock_t *pxWindow = &batch[r]->temperatureWindow;
+        for (uint16_t i = 0U; i < pxWindow->count; i++) {
+            usMin = (pxWindow->values[i] < usMin) ? pxWindow->values[i] : usMin;
+            usMax = (pxWindow->values[i] > usMax) ? pxWindow->values[i] : usMax;
+        }
+        ulSamples += pxWindow->count;
+    }
+    if (ulSamples > 1U && len < size) {
+        snprintf(&msg[len], size - len, "  Window: %lu (%u..%uC)",
+                 (unsigned long)ulSamples, (unsigned int)usMin, (unsigned int)usMax);
+    }
+}
+
 /**
  * @brief Helper function to log messages for the control_devices function.
  * 
@@ -122,12 +237,12 @@ static void control_devices(uint16_t temperature, uint16_t motion)
 */
 static void log_messages(const char* taskname, const char* message)
 {
+    PROFILE_SCOPE(PROFILE_LOG_MESSAGES);
+
     char msg[LOG_MSG_MAX_LEN];
     BaseType_t xRet = pdFALSE;
 
     snprintf(msg, sizeof(msg), "[%-12s] %s", taskname, message);
     xRet = xQueueSend(xLogQueue, msg, 0U);
-    if (xRet != pdTRUE) {
-        /* Log queue full — increment error counter or set error flag */
-    }
+    rstats_record_send(RSTATS_LOG_QUEUE, xRet);
 }
\ No newline at end of file
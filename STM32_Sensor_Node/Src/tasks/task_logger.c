@@ -16,6 +16,7 @@
 
 #include "uart.h"
 #include "tasks.h"
+#include "profile.h"
 #include "shared_resources.h"
 
 void vTaskLogger(void *pvParameters)
@@ -29,6 +30,7 @@ void vTaskLogger(void *pvParameters)
     {
         ret = xQueueReceive(xLogQueue, msg, portMAX_DELAY);
         if (ret == pdTRUE) {
+            PROFILE_SCOPE(PROFILE_UART2_WRITE);
             msg[LOG_MSG_MAX_LEN - 1] = '\0';  // Ensure null termination
             printf("%s\n\r", msg);
         }
@@ -3,28 +3,60 @@
  * @brief Sensor data reading task.
  * 
  * Reads sensor data from the Room object via the C wrapper interface,
- * logs the values, packages them into a SensorData_t struct, and sends
- * the struct to the Sensor Queue for the controller task to consume.
+ * logs the values, packages them into a SampleRecord_t from the sample pool,
+ * and sends its pointer to the Sensor Queue for the controller task to consume.
+ * The record also carries, as one block, every temperature sample the Room
+ * recorded since the previous record, including those the task slept through.
+ * 
+ * The task sleeps until the Room reports a change past the deadband (a
+ * direct-to-task notification from the writer) or, as a heartbeat, until
+ * SENSOR_READ_HEARTBEAT_PERIODS sample periods pass without one. Heartbeats
+ * follow absolute deadlines, so quiet stretches are read without drift.
 */
 
+#include <stdio.h>
 #include <stdint.h>
 
 #include "FreeRTOS.h"
 #include "task.h"
-#include "semphr.h"
+#include "queue.h"
 
 #include "wrapper.h"
+#include "latency.h"
+#include "sample_source.h"
+#include "periodic.h"
+#include "sample_pool.h"
+#include "rstats.h"
 #include "shared_resources.h"
-#include "task_logger.h"
-#include "task_sensor_read.h"
+#include "tasks.h"
+
+/** @brief Temperature change (C) that wakes the reader; smaller drifts wait for the heartbeat */
+#ifndef SENSOR_TEMPERATURE_DEADBAND
+#define SENSOR_TEMPERATURE_DEADBAND     (0U)
+#endif
+
+/** @brief Motion change that wakes the reader (0: any change) */
+#ifndef SENSOR_MOTION_DEADBAND
+#define SENSOR_MOTION_DEADBAND          (0U)
+#endif
 
-#define SENSOR_READ_TASK_PERIOD_MS    (10000U)
+/** @brief Sample periods without a change before reading anyway (0: only on change) */
+#ifndef SENSOR_READ_HEARTBEAT_PERIODS
+#define SENSOR_READ_HEARTBEAT_PERIODS   (6U)
+#endif
+
+/** @brief Registry slot of the default room, the one getSensorSnapshot() reads */
+#define SENSOR_READ_ROOM_INDEX          (0U)
+
+// Local function prototypes
+static void sensor_changed(uint16_t roomIndex, void *context);
+static TickType_t heartbeat_ticks(void);
 
 /**
  * @brief Sensor read task entry point.
  *
- * Periodically reads sensor values from the Room object (mutex-protected),
- * logs them, packages them into a struct, and sends to the controller task.
+ * Reads sensor values from the Room object (lock-free snapshot) whenever they change,
+ * logs them, packages them into a pooled record, and hands it to the controller task.
 */
 void vTaskSensorRead(void *pvParameters)
 {
@@ -32,38 +64,91 @@ void vTaskSensorRead(void *pvParameters)
 
     char       msg[LOG_MSG_MAX_LEN];
     BaseType_t xRet          = pdFALSE;
-    uint16_t   usTempValue   = 0U;
-    uint16_t   usMotionValue = 0U;
-    SensorData_t sensorData  = {0U};
+    RoomSample_t snapshot    = {0U};
+    SampleRecord_t *pxRecord = NULL;
+    TickType_t   xReadAt     = 0U;
+    TickType_t   xHeartbeat  = 0U;
+    uint32_t     ulRecorded  = 0U;  // Room samples recorded as of the last record's window
+
+    // Wake on changes instead of polling
+    setSensorObserver(sensor_changed, (void *)xTaskGetCurrentTaskHandle(),
+                      SENSOR_TEMPERATURE_DEADBAND, SENSOR_MOTION_DEADBAND);
+    periodic_start(PERIODIC_SENSOR_READ);
 
     while (1) 
     {
-        // Read from Room object via C wrapper
-        xSemaphoreTake(xSensorMutex, portMAX_DELAY);        // Take the mutex
-        usTempValue = getTemperature();
-        usMotionValue = getMotion();
-        xRet = xSemaphoreGive(xSensorMutex);                // Release the mutex
-        configASSERT(xRet == pdTRUE);                       // Ensure mutex was released successfully
+        // Read a consistent snapshot of all Room sensors via C wrapper, without blocking
+        getSensorSnapshot(&snapshot);
+
+        xReadAt = xTaskGetTickCount();
+        latency_record(LATENCY_WRITE_TO_READ, xReadAt - (TickType_t)snapshot.sampleTime);
 
         // Log read values
-        LOG_SENSOR_DATA(msg, "SensorRead", "Get sensor values:", usTempValue, usMotionValue);
+        LOG_SENSOR_DATA(msg, "SensorRead", "Get sensor values:", snapshot.temperature, snapshot.motion);
         xRet = xQueueSend(xLogQueue, (const void *)msg, 0U);
-        if (xRet != pdTRUE) {
-            /* Log queue full — drop message */
-        }
+        rstats_record_send(RSTATS_LOG_QUEUE, xRet);
+
+        // Package sensor data into a pooled record; only its pointer is queued.
+        // With every record still in flight the sample is dropped, counted against the pool
+        pxRecord = sample_pool_take();
+        rstats_record_send(RSTATS_SAMPLE_POOL, (pxRecord != NULL) ? pdTRUE : pdFALSE);
+        if (pxRecord != NULL) {
+            pxRecord->temperature = snapshot.temperature;
+            pxRecord->motion      = snapshot.motion;
+            pxRecord->timestamp   = 0U;
+            pxRecord->sampledAt   = (TickType_t)snapshot.sampleTime;
+            pxRecord->readAt      = xReadAt;
 
-        // Package sensor data into struct 
-        sensorData.temperature = usTempValue;
-        sensorData.motion      = usMotionValue;
+            // Temperature samples since the previous record, in one block; after a dropped
+            // record they go with the next one (up to SAMPLE_BLOCK_LEN)
+            (void)getSensorBlock(SENSOR_TEMPERATURE, ulRecorded, &pxRecord->temperatureWindow);
+            ulRecorded = pxRecord->temperatureWindow.recorded;
 
-        // Send to controller task via Sensor Queue
-        xRet = xQueueSend(xSensorQueue, &sensorData, 0U);
-        if (xRet != pdTRUE) {
-            /* Sensor queue full — drop data */
+            // Send to controller task via Sensor Queue, which then owns the record
+            xRet = xQueueSend(xSensorQueue, &pxRecord, 0U);
+            rstats_record_send(RSTATS_SENSOR_QUEUE, xRet);
+            if (xRet != pdTRUE) {
+                sample_pool_give(pxRecord);
+            }
         }
 
-        // Sleep until next read cycle
-        vTaskDelay(pdMS_TO_TICKS(SENSOR_READ_TASK_PERIOD_MS));
+        // Sleep until the Room changes, or the heartbeat is due
+        if (SENSOR_READ_HEARTBEAT_PERIODS > 0U) {
+            xHeartbeat = heartbeat_ticks();
+            (void)periodic_wait_notify(PERIODIC_SENSOR_READ, xHeartbeat);
+        } else {
+            (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
     }
 
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Room change observer, runs in vTaskSensorWrite's context.
+ * 
+ * Wakes this task with a direct-to-task notification when the default room changed;
+ * values within the deadband never get here, and changes of other rooms are ignored,
+ * so neither costs a wake-up.
+ * 
+ * @param roomIndex Slot of the room that changed.
+ * @param context   Handle of the vTaskSensorRead task.
+*/
+static void sensor_changed(uint16_t roomIndex, void *context)
+{
+    if (roomIndex == SENSOR_READ_ROOM_INDEX) {
+        xTaskNotifyGive((TaskHandle_t)context);
+    }
+}
+
+/**
+ * @brief Heartbeat period: SENSOR_READ_HEARTBEAT_PERIODS sample periods.
+ *
+ * A paused source (portMAX_DELAY period) keeps portMAX_DELAY, and a product that
+ * does not fit in TickType_t saturates there instead of wrapping to a short period.
+*/
+static TickType_t heartbeat_ticks(void)
+{
+    uint64_t ticks = (uint64_t)SENSOR_READ_HEARTBEAT_PERIODS * sample_source_period_ticks();
+
+    return (ticks >= portMAX_DELAY) ? portMAX_DELAY : (TickType_t)ticks;
+}
@@ -1,33 +1,36 @@
 /**
- * @file task_sensor.c
+ * @file task_sensor_write.c
  * @brief Sensor data simulation task.
  * 
- * Simulates sensor readings using rand() and writes them into the Room object via the C wrapper interface.
+ * Simulates sensor readings using the configurable sample source and writes them into
+ * the Room object via the C wrapper interface.
  * In a real application, this would be replaced with actual hardware peripheral reads.
  * Sends log messages to the logger task via a FreeRTOS queue.
 */
 
+#include <stdio.h>
 #include <stdint.h>
-#include <stdlib.h>
 
 #include "FreeRTOS.h"
 #include "task.h"
-#include "semphr.h"
+#include "queue.h"
 
 #include "wrapper.h"
+#include "sample_source.h"
+#include "periodic.h"
+#include "backpressure.h"
+#include "rstats.h"
 #include "shared_resources.h"
-#include "task_logger.h"
-#include "task_sensor_write.h"
-
-#define SENSOR_TASK_PERIOD_MS    (10000U)
-#define SENSOR_TEMP_MAX          (100U)
-#define SENSOR_MOTION_MAX        (2U)
+#include "tasks.h"
 
 /**
  * @brief Sensor simulation task entry point.
  * 
- * Periodically generates simulated temperature and motion values,
- * writes them to the Room object, and logs the results.
+ * Generates simulated temperature and motion values at the sample source rate,
+ * writes them to the Room object, and logs the results. Samples are due on absolute
+ * deadlines, so the time spent writing and logging does not stretch the period.
+ * While the pipeline downstream is backed up, the period is stretched on purpose
+ * (backpressure.h) so samples are taken less often instead of dropped later.
  * 
  * @param pvParameters Unused parameter required by FreeRTOS task signature.
 */
@@ -35,32 +38,30 @@ void vTaskSensorWrite(void *pvParameters)
 {
     (void)pvParameters;                 // Suppress unused parameter warning
 
-    char       msg[LOG_MSG_MAX_LEN];
-    BaseType_t xRet         = pdFALSE;
-    uint16_t   usTempValue   = 0U;
-    uint16_t   usMotionValue = 0U;
+    char          msg[LOG_MSG_MAX_LEN];
+    BaseType_t    xRet       = pdFALSE;
+    SampleValue_t sample     = {0U};
+    RoomSample_t  snapshot   = {0U};
+
+    periodic_start(PERIODIC_SENSOR_WRITE);
 
     while (1) 
     {
-        // Simulate sensor readings
-        usTempValue   = (uint16_t)(rand() % (int)SENSOR_TEMP_MAX);       // 0-99
-        usMotionValue = (uint16_t)(rand() % (int)SENSOR_MOTION_MAX);     // 0 or 1
+        // Simulate sensor readings, stamped at creation for latency tracking
+        sample_source_next(&sample);
+        snapshot.temperature = sample.temperature;
+        snapshot.motion      = sample.motion;
+        snapshot.sampleTime  = (uint32_t)xTaskGetTickCount();
 
-        // Write to Room object via C wrapper
-        xSemaphoreTake(xSensorMutex, portMAX_DELAY);        // Take the mutex
-        setTemperature(usTempValue);
-        setMotion(usMotionValue);
-        xRet = xSemaphoreGive(xSensorMutex);                // Release the mutex
-        configASSERT(xRet == pdTRUE);                       // Ensure mutex was released successfully
+        // Publish the whole sample to the Room via C wrapper (seqlock, no mutex)
+        setSensorSnapshot(&snapshot);
 
         // Log written values
-        LOG_SENSOR_DATA(msg, "SensorWrite", "Set sensor values:", usTempValue, usMotionValue);
+        LOG_SENSOR_DATA(msg, "SensorWrite", "Set sensor values:", sample.temperature, sample.motion);
         xRet = xQueueSend(xLogQueue, (const void *)msg, 0U);
-        if (xRet != pdTRUE) {
-            /* Log queue full — drop message */
-        }
+        rstats_record_send(RSTATS_LOG_QUEUE, xRet);
 
-        // Sleep until next period
-        vTaskDelay(pdMS_TO_TICKS(SENSOR_TASK_PERIOD_MS));
+        // Sleep until the next sample is due, one period after this one was (longer under backpressure)
+        (void)periodic_wait(PERIODIC_SENSOR_WRITE, backpressure_scale_delay(sample_source_next_delay()));
     }
 }
\ No newline at end of file
@@ -0,0 +1,213 @@
+/**
+ * @file task_soak_monitor.c
+ * @brief Soak-run monitor task.
+ *
+ * Every SOAK_REPORT_INTERVAL_S of (simulated) time, reports heap_4 usage and
+ * fragmentation, the lowest free heap ever seen, the send/drop/full-event counts and
+ * high-water marks of the shared queues, stream buffer and sample pool, the
+ * backpressure state, and the missed deadlines and wake-up jitter (ticks) of the
+ * periodic tasks. At the end of the run it adds task stack high-water marks and the
+ * latency histograms; the host build then exits so soak runs can be scripted.
+*/
+
+#include "soak_monitor.h"
+
+#if defined(SOAK_MONITOR)
+
+#include <stdio.h>
+#include <stdint.h>
+
+#if defined(HOST_BUILD)
+#include <stdlib.h>
+#include <time.h>
+#endif
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "latency.h"
+#include "backpressure.h"
+#include "periodic.h"
+#include "rstats.h"
+#include "shared_resources.h"
+#include "tasks.h"
+
+#define SOAK_TASK_NAME          "SoakMonitor"
+
+// Local function prototypes
+static void soak_report(TickType_t xElapsed, BaseType_t xFinal);
+static void soak_report_stacks(void);
+static void soak_log(const char *msg);
+static void soak_wait_log_drained(void);
+#if defined(HOST_BUILD)
+static double wall_seconds(void);
+#endif
+
+#if defined(HOST_BUILD)
+static double dWallStart = 0.0;
+#endif
+
+/**
+ * @brief Soak monitor task entry point.
+ *
+ * Wakes once per report interval. Runs at the Logger's priority and sends its lines
+ * with blocking sends, so the report itself never causes log drops.
+*/
+void vTaskSoakMonitor(void *pvParameters)
+{
+    (void)pvParameters;                 // Suppress unused parameter warning
+
+    const TickType_t xInterval = (TickType_t)SOAK_REPORT_INTERVAL_S * configTICK_RATE_HZ;
+    const TickType_t xDuration = (TickType_t)SOAK_DURATION_S * configTICK_RATE_HZ;
+    TickType_t xStart    = xTaskGetTickCount();
+    TickType_t xLastWake = xStart;
+    TickType_t xElapsed  = 0U;
+    BaseType_t xFinal    = pdFALSE;
+
+#if defined(HOST_BUILD)
+    dWallStart = wall_seconds();
+#endif
+
+    while (1)
+    {
+        vTaskDelayUntil(&xLastWake, xInterval);
+
+        xElapsed = xLastWake - xStart;
+        xFinal   = (xDuration != 0U && xElapsed >= xDuration) ? pdTRUE : pdFALSE;
+        soak_report(xElapsed, xFinal);
+
+        if (xFinal == pdTRUE) {
+            soak_wait_log_drained();
+#if defined(HOST_BUILD)
+            fflush(stdout);
+            exit(0);
+#else
+            vTaskSuspend(NULL);         // Keep the system running, stop reporting
+#endif
+        }
+    }
+}
+
+/**
+ * @brief Log one report.
+ *
+ * @param xElapsed  Ticks since the monitor started.
+ * @param xFinal    pdTRUE for the end-of-run report, which adds stacks and latency.
+*/
+static void soak_report(TickType_t xElapsed, BaseType_t xFinal)
+{
+    char msg[LOG_MSG_MAX_LEN];
+    HeapStats_t heap;
+    RStats_t stats;
+    PeriodicStats_t sched;
+    BackpressureStats_t pressure;
+    unsigned long ulSeconds = (unsigned long)(xElapsed / configTICK_RATE_HZ);
+    unsigned long ulFragPct = 0UL;
+
+    vPortGetHeapStats(&heap);
+    if (heap.xAvailableHeapSpaceInBytes > 0U) {
+        // Share of the free heap that the largest block cannot serve
+        ulFragPct = 100UL - (unsigned long)(((uint64_t)heap.xSizeOfLargestFreeBlockInBytes * 100U) /
+                                            heap.xAvailableHeapSpaceInBytes);
+    }
+
+    snprintf(msg, sizeof(msg), "[%-12s] %s t=%lu:%02lu:%02lu",
+             SOAK_TASK_NAME, (xFinal == pdTRUE) ? "Final report" : "Report",
+             ulSeconds / 3600UL, (ulSeconds / 60UL) % 60UL, ulSeconds % 60UL);
+    soak_log(msg);
+
+    snprintf(msg, sizeof(msg), "[%-12s] Heap free: %lu  min ever: %lu  largest: %lu  blocks: %lu  frag: %lu%%",
+             SOAK_TASK_NAME, (unsigned long)heap.xAvailableHeapSpaceInBytes,
+             (unsigned long)xPortGetMinimumEverFreeHeapSize(),
+             (unsigned long)heap.xSizeOfLargestFreeBlockInBytes,
+             (unsigned long)heap.xNumberOfFreeBlocks, ulFragPct);
+    soak_log(msg);
+
+    snprintf(msg, sizeof(msg), "[%-12s] Heap allocs: %lu  frees: %lu",
+             SOAK_TASK_NAME, (unsigned long)heap.xNumberOfSuccessfulAllocations,
+             (unsigned long)heap.xNumberOfSuccessfulFrees);
+    soak_log(msg);
+
+    for (uint32_t res = 0U; res < (uint32_t)RSTATS_RESOURCE_COUNT; res++) {
+        rstats_get((RStatsResource_t)res, &stats);
+        snprintf(msg, sizeof(msg), "[%-12s] %-12s sent: %lu  dropped: %lu  full: %lu  high-water: %lu/%lu",
+                 SOAK_TASK_NAME, rstats_name((RStatsResource_t)res),
+                 (unsigned long)stats.sent, (unsigned long)stats.dropped,
+                 (unsigned long)stats.fullEvents, (unsigned long)stats.highWater, (unsigned long)stats.capacity);
+        soak_log(msg);
+    }
+
+    backpressure_get(&pressure);
+    snprintf(msg, sizeof(msg), "[%-12s] Backpressure level: %lu  max: %lu/%lu  throttles: %lu  fill: %lu%%",
+             SOAK_TASK_NAME, (unsigned long)pressure.level, (unsigned long)pressure.maxLevel,
+             (unsigned long)BACKPRESSURE_MAX_LEVEL, (unsigned long)pressure.throttles,
+             (unsigned long)pressure.fillPct);
+    soak_log(msg);
+
+    for (uint32_t task = 0U; task < (uint32_t)PERIODIC_TASK_COUNT; task++) {
+        periodic_get((PeriodicTask_t)task, &sched);
+        snprintf(msg, sizeof(msg), "[%-12s] %-12s wake-ups: %lu  notified: %lu  missed: %lu  jitter last/max/avg: %lu/%lu/%lu",
+                 SOAK_TASK_NAME, periodic_name((PeriodicTask_t)task),
+                 (unsigned long)sched.wakeups, (unsigned long)sched.notified, (unsigned long)sched.missed,
+                 (unsigned long)sched.lastJitter, (unsigned long)sched.maxJitter,
+                 (sched.wakeups > 0U) ? (unsigned long)(sched.totalJitter / sched.wakeups) : 0UL);
+        soak_log(msg);
+    }
+
+#if defined(HOST_BUILD)
+    double dWall = wall_seconds() - dWallStart;
+    snprintf(msg, sizeof(msg), "[%-12s] Wall time: %.2f s  speed-up: %.0fx",
+             SOAK_TASK_NAME, dWall, (dWall > 0.0) ? (double)ulSeconds / dWall : 0.0);
+    soak_log(msg);
+#endif
+
+    if (xFinal == pdTRUE) {
+        soak_report_stacks();
+        soak_wait_log_drained();        // latency_dump() does not wait for queue space
+        latency_dump();
+    }
+}
+
+/** @brief Log the stack high-water mark (lowest free stack, in words) of every task */
+static void soak_report_stacks(void)
+{
+    static TaskStatus_t tasks[SOAK_MAX_TASKS];
+    char msg[LOG_MSG_MAX_LEN];
+    UBaseType_t uxCount;
+
+    uxCount = uxTaskGetSystemState(tasks, SOAK_MAX_TASKS, NULL);
+    for (UBaseType_t i = 0U; i < uxCount; i++) {
+        snprintf(msg, sizeof(msg), "[%-12s] Stack %-12s min free: %lu words",
+                 SOAK_TASK_NAME, tasks[i].pcTaskName,
+                 (unsigned long)tasks[i].usStackHighWaterMark);
+        soak_log(msg);
+    }
+}
+
+/** @brief Send one line to the Logger Queue, waiting for space */
+static void soak_log(const char *msg)
+{
+    BaseType_t xRet = xQueueSend(xLogQueue, msg, portMAX_DELAY);
+    rstats_record_send(RSTATS_LOG_QUEUE, xRet);
+}
+
+/** @brief Wait until the Logger has emptied the Logger Queue */
+static void soak_wait_log_drained(void)
+{
+    while (uxQueueMessagesWaiting(xLogQueue) > 0U) {
+        vTaskDelay(1U);
+    }
+    vTaskDelay(1U);                     // Let the Logger print the line it took last
+}
+
+#if defined(HOST_BUILD)
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+#endif
+
+#endif /* SOAK_MONITOR */
@@ -11,42 +11,101 @@
 #include "task.h"
 #include "queue.h"
 
-#include "task_logger.h"
-#include "task_transmit.h"
+#include "wrapper.h"
+#include "tasks.h"
+#include "latency.h"
+#include "profile.h"
+#include "rstats.h"
+#include "sample_pool.h"
 #include "shared_resources.h"
 
+#define DEVICE_CHANGES_MAX      (8U)        // Device changes taken per call
+#define TRANSMIT_RECORDS_MAX    (8U)        // Record pointers taken from the stream buffer per call
+
+// Local function prototypes
+static void publish_device_changes(char *msg, size_t size);
+
 void vTaskTransmit(void *pvParameters)
 {
     (void)pvParameters;                 // Suppress unused parameter warning
 
     char msg[LOG_MSG_MAX_LEN];
     BaseType_t      xRet;
-    TransmitData_t  txData = {0U};
+    SampleRecord_t *records[TRANSMIT_RECORDS_MAX];
+    SampleRecord_t *pxRecord = NULL;
+    size_t          bytesRead = 0U;
+    TickType_t      xNow   = 0U;
+    uint32_t        ulSamplesSinceDump = 0U;
+    uint32_t        ulSamplesSinceProfile = 0U;
+
+    markAllDevicesDirty();              // First publish carries every device state
 
     while (1) 
     {
-        // 1. Block waiting for transmit data struct from stream buffer
-        xRet = xStreamBufferReceive(xStreamBuffer, &txData, sizeof(TransmitData_t), portMAX_DELAY);
-        if (xRet != sizeof(TransmitData_t)) {
-            // Handle error (e.g., log, continue, etc.)
-            continue;
-        }
+        // 1. Block waiting for sample records from stream buffer; the controller only writes whole pointers
+        bytesRead = xStreamBufferReceive(xStreamBuffer, records, sizeof(records), portMAX_DELAY);
 
-        // 2. Send to ESP32 via UART
-        // Future addition
+        for (uint32_t i = 0U; i < (uint32_t)(bytesRead / sizeof(SampleRecord_t *)); i++) {
+            pxRecord = records[i];
+            xNow = xTaskGetTickCount();
+            latency_record(LATENCY_CONTROLLER_TO_TRANSMIT, xNow - pxRecord->timestamp);
+            latency_record(LATENCY_END_TO_END, xNow - pxRecord->sampledAt);
 
-        // 3. Log the transmitted sensor data
-        LOG_TRANSMIT_DATA(msg, "Transmit", "Transmit to ESP32:", txData.temperature, txData.motion, txData.timestamp);
-        xRet = xQueueSend(xLogQueue, msg, 0);
-        if (xRet != pdTRUE) {
-            // Log queue is full, handle error as needed (e.g., drop message, set error flag)
-        }
+            // 2. Send to ESP32 via UART
+            // Future addition
+
+            // 3. Log the transmitted sensor data
+            LOG_TRANSMIT_DATA(msg, "Transmit", "Transmit to ESP32:", pxRecord->temperature, pxRecord->motion, pxRecord->timestamp);
+            xRet = xQueueSend(xLogQueue, msg, 0);
+            rstats_record_send(RSTATS_LOG_QUEUE, xRet);
+
+            // Last stage: the record goes back to the pool
+            sample_pool_give(pxRecord);
+
+            // Only the devices that changed since the last sample
+            publish_device_changes(msg, sizeof(msg));
 
-        // Send blank line to separate data cycles
-        snprintf(msg, sizeof(msg), " ");
-        xRet = xQueueSend(xLogQueue, msg, 0);
-        if (xRet != pdTRUE) {
-            // Log queue is full
+            // Send blank line to separate data cycles
+            snprintf(msg, sizeof(msg), " ");
+            xRet = xQueueSend(xLogQueue, msg, 0);
+            rstats_record_send(RSTATS_LOG_QUEUE, xRet);
+
+            // 4. Periodically dump the latency histograms
+            if (LATENCY_DUMP_INTERVAL > 0U && ++ulSamplesSinceDump >= LATENCY_DUMP_INTERVAL) {
+                ulSamplesSinceDump = 0U;
+                latency_dump();
+            }
+
+            // 5. Periodically dump the profiling probes
+            if (PROFILE_ENABLED && PROFILE_DUMP_INTERVAL > 0U && ++ulSamplesSinceProfile >= PROFILE_DUMP_INTERVAL) {
+                ulSamplesSinceProfile = 0U;
+                PROFILE_DUMP();
+            }
         }
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Log every device whose state changed since the last call.
+ * 
+ * Drains the registry's dirty mask DEVICE_CHANGES_MAX entries at a time, so an
+ * unchanged building costs one scan of the mask and no output.
+*/
+static void publish_device_changes(char *msg, size_t size)
+{
+    static const char *const kindNames[DEVICE_KIND_COUNT] = { "Light", "AC", "Heater" };
+    DeviceChange_t changes[DEVICE_CHANGES_MAX];
+    uint16_t       count = 0U;
+    BaseType_t     xRet;
+
+    do {
+        count = takeDeviceChanges(changes, DEVICE_CHANGES_MAX);
+        for (uint16_t i = 0U; i < count; i++) {
+            snprintf(msg, size, "[%-12s] %-18s Room: %u  %s %s", "Transmit", "Device change:",
+                     (unsigned int)getRoomNumber(changes[i].roomIndex),
+                     kindNames[changes[i].kind], changes[i].on ? "on" : "off");
+            xRet = xQueueSend(xLogQueue, msg, 0);
+            rstats_record_send(RSTATS_LOG_QUEUE, xRet);
+        }
+    } while (count == DEVICE_CHANGES_MAX);
+}
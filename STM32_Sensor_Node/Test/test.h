@@ -0,0 +1,42 @@
+#ifndef TEST_H_
+#define TEST_H_
+
+/**
+ * @file test.h
+ * @brief Minimal host test harness shared by the Test/ programs.
+ *
+ * Each program is a set of test functions run by TEST_RUN(). TEST_CHECK() reports a
+ * failed condition with its location and keeps going, so one run lists every failure.
+ * test_finish() prints the summary and returns the exit status of the program.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+
+static uint32_t test_checks;
+static uint32_t test_failures;
+
+/** @brief Check a condition; a failure is reported but does not stop the test */
+#define TEST_CHECK(cond)        test_check((cond), #cond, __FILE__, __LINE__)
+
+/** @brief Run one test function and name it in the output */
+#define TEST_RUN(fn)            do { puts(#fn); fn(); } while (0)
+
+static inline void test_check(bool ok, const char *expr, const char *file, int line)
+{
+    test_checks++;
+    if (!ok) {
+        test_failures++;
+        printf("%s:%d: check failed: %s\n", file, line, expr);
+    }
+}
+
+/** @brief Print the summary; returns 0 if every check passed */
+static inline int test_finish(const char *program)
+{
+    printf("%s: %lu checks, %lu failed\n", program,
+           (unsigned long)test_checks, (unsigned long)test_failures);
+    return (test_failures == 0U) ? 0 : 1;
+}
+
+#endif /* TEST_H_ */
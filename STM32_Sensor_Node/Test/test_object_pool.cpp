@@ -0,0 +1,183 @@
+/**
+ * @file test_object_pool.cpp
+ * @brief Host tests for ObjectPool.
+ *
+ * destroy() must reject anything that is not a live object of the pool (nullptr,
+ * a second free, a pointer into the middle of a slot, a pointer of another pool or
+ * outside any pool) and leave the pool untouched. Freed slots must be reused,
+ * most recently freed first, before any slot that was never used.
+ *
+ * Build and run with `make test`.
+*/
+
+#include <stdint.h>
+
+#include "test.h"
+#include "object_pool.h"
+
+#define POOL_CAPACITY       (4U)
+
+namespace {
+
+// Counts constructor and destructor calls, so the tests see what the pool ran
+struct Tracked {
+    static uint32_t constructed;
+    static uint32_t destroyed;
+
+    uint32_t id;
+    uint32_t payload[3];
+
+    explicit Tracked(uint32_t newId) : id(newId), payload{newId, newId, newId} {
+        constructed++;
+    }
+
+    ~Tracked() {
+        destroyed++;
+    }
+};
+
+uint32_t Tracked::constructed = 0U;
+uint32_t Tracked::destroyed   = 0U;
+
+typedef ObjectPool<Tracked, POOL_CAPACITY> TrackedPool;
+
+void reset_counts() {
+    Tracked::constructed = 0U;
+    Tracked::destroyed   = 0U;
+}
+
+/** Capacity objects fit, the next create fails, and arguments reach the constructor */
+void test_create_until_full() {
+    static TrackedPool pool;
+    Tracked* objects[POOL_CAPACITY];
+
+    reset_counts();
+    for (uint32_t i = 0U; i < POOL_CAPACITY; i++) {
+        objects[i] = pool.create(100U + i);
+        TEST_CHECK(objects[i] != nullptr);
+        TEST_CHECK(objects[i] != nullptr && objects[i]->id == 100U + i);
+        TEST_CHECK(pool.owns(objects[i]));
+    }
+    TEST_CHECK(pool.create(999U) == nullptr);
+    TEST_CHECK(pool.inUse() == POOL_CAPACITY);
+    TEST_CHECK(pool.available() == 0U);
+    TEST_CHECK(Tracked::constructed == POOL_CAPACITY);
+
+    for (uint32_t i = 0U; i < POOL_CAPACITY; i++) {
+        TEST_CHECK(pool.destroy(objects[i]));
+    }
+    TEST_CHECK(pool.inUse() == 0U);
+    TEST_CHECK(Tracked::destroyed == POOL_CAPACITY);
+}
+
+/** A second destroy of the same object is refused and runs no destructor */
+void test_double_free_rejected() {
+    static TrackedPool pool;
+
+    reset_counts();
+    Tracked* a = pool.create(1U);
+    Tracked* b = pool.create(2U);
+
+    TEST_CHECK(pool.destroy(a));
+    TEST_CHECK(!pool.destroy(a));
+    TEST_CHECK(Tracked::destroyed == 1U);
+    TEST_CHECK(pool.inUse() == 1U);
+
+    // The free list is intact: the slot comes back once, then fresh slots follow
+    Tracked* c = pool.create(3U);
+    Tracked* d = pool.create(4U);
+    TEST_CHECK(c == a);
+    TEST_CHECK(d != nullptr && d != a && d != b);
+    TEST_CHECK(pool.inUse() == 3U);
+}
+
+/** Pointers into the middle of a slot, or just past the storage, are refused */
+void test_misaligned_pointer_rejected() {
+    static TrackedPool pool;
+
+    reset_counts();
+    Tracked* a = pool.create(1U);
+    Tracked* b = pool.create(2U);
+    unsigned char* bytes = reinterpret_cast<unsigned char*>(a);
+
+    for (size_t offset = 1U; offset < sizeof(Tracked); offset++) {
+        Tracked* inside = reinterpret_cast<Tracked*>(bytes + offset);
+        TEST_CHECK(!pool.owns(inside));
+        TEST_CHECK(!pool.destroy(inside));
+    }
+    Tracked* pastEnd = reinterpret_cast<Tracked*>(bytes + POOL_CAPACITY * sizeof(Tracked));
+    TEST_CHECK(!pool.owns(pastEnd));
+    TEST_CHECK(!pool.destroy(pastEnd));
+
+    TEST_CHECK(Tracked::destroyed == 0U);
+    TEST_CHECK(pool.inUse() == 2U);
+    TEST_CHECK(a->id == 1U && b->id == 2U);
+}
+
+/** Objects of another pool, outside any pool, and nullptr are refused */
+void test_foreign_pointer_rejected() {
+    static TrackedPool pool;
+    static TrackedPool other;
+
+    reset_counts();
+    Tracked* mine   = pool.create(1U);
+    Tracked* theirs = other.create(2U);
+    Tracked  local(3U);
+
+    TEST_CHECK(!pool.owns(theirs));
+    TEST_CHECK(!pool.destroy(theirs));
+    TEST_CHECK(!pool.owns(&local));
+    TEST_CHECK(!pool.destroy(&local));
+    TEST_CHECK(!pool.owns(nullptr));
+    TEST_CHECK(!pool.destroy(nullptr));
+
+    TEST_CHECK(Tracked::destroyed == 0U);
+    TEST_CHECK(pool.inUse() == 1U);
+    TEST_CHECK(other.inUse() == 1U);
+    TEST_CHECK(other.destroy(theirs));
+    TEST_CHECK(pool.destroy(mine));
+}
+
+/** Freed slots are reused last-freed first, before the never-used slots */
+void test_free_list_reuse() {
+    static TrackedPool pool;
+    Tracked* objects[POOL_CAPACITY - 1U];
+
+    reset_counts();
+    for (uint32_t i = 0U; i < POOL_CAPACITY - 1U; i++) {
+        objects[i] = pool.create(i);
+    }
+    TEST_CHECK(pool.destroy(objects[0]));
+    TEST_CHECK(pool.destroy(objects[2]));
+
+    Tracked* first  = pool.create(10U);
+    Tracked* second = pool.create(11U);
+    Tracked* fresh  = pool.create(12U);
+    TEST_CHECK(first == objects[2]);
+    TEST_CHECK(second == objects[0]);
+    TEST_CHECK(fresh != nullptr && fresh != objects[0] && fresh != objects[1] && fresh != objects[2]);
+    TEST_CHECK(first->id == 10U && second->id == 11U && fresh->id == 12U);
+    TEST_CHECK(pool.create(13U) == nullptr);
+    TEST_CHECK(pool.inUse() == POOL_CAPACITY);
+
+    // Churn on one slot never grows into the others
+    TEST_CHECK(pool.destroy(fresh));
+    for (uint32_t i = 0U; i < 100U; i++) {
+        Tracked* again = pool.create(i);
+        TEST_CHECK(again == fresh);
+        TEST_CHECK(pool.destroy(again));
+    }
+    TEST_CHECK(pool.inUse() == POOL_CAPACITY - 1U);
+    TEST_CHECK(Tracked::constructed == Tracked::destroyed + pool.inUse());
+}
+
+} // namespace
+
+int main() {
+    TEST_RUN(test_create_until_full);
+    TEST_RUN(test_double_free_rejected);
+    TEST_RUN(test_misaligned_pointer_rejected);
+    TEST_RUN(test_foreign_pointer_rejected);
+    TEST_RUN(test_free_list_reuse);
+    return test_finish("test_object_pool");
+}
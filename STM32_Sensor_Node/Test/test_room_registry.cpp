@@ -0,0 +1,460 @@
+/**
+ * @file test_room_registry.cpp
+ * @brief Host tests for RoomRegistry.
+ *
+ * Covers the per-slot seqlock: readers running against one writer must only ever
+ * see the fields of one completed write, and a reader that finds a write in
+ * progress (odd sequence) must wait for it rather than return a torn sample.
+ *
+ * Covers the sample history: every write path records the room's resulting
+ * sample, readHistory() returns the newest ones oldest first across the ring's
+ * wrap, and readers running against the writer only see windows of consecutive,
+ * completed writes. readBlock() takes one sensor's new samples as a block.
+ *
+ * Covers the device bitmaps over DEVICE_ROOMS rooms, one full bitmap word and a
+ * partial one: takeDeviceChanges() in chunks smaller than a word (the rest of a
+ * word is put back), markAllDevicesDirty() and controlAll().
+ *
+ * Build and run with `make test`.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "test.h"
+#include "room_registry.h"
+
+#define SEQLOCK_WRITES      (1000000U)      // Samples published by the writer thread
+#define SEQLOCK_READERS     (3U)            // Reader threads checking every snapshot
+#define SEQLOCK_ROOMS       (2U)            // Slots written and read together
+#define HISTORY_WRITES      (200000U)       // Samples recorded while readers copy windows
+#define DEVICE_ROOMS        (40U)           // 32 rooms in bitmap word 0, 8 in word 1
+#define DEVICE_CHUNK        (16U)           // Changes taken per call, half a bitmap word
+#define AC_ABOVE            (30U)
+#define HEATER_BELOW        (18U)
+
+/** @brief Drives the seqlock writer side of a registry step by step */
+class RoomRegistryTest {
+public:
+    static void beginWrite(RoomRegistry& registry, uint16_t index) {
+        registry.beginWrite(index);
+    }
+
+    static void endWrite(RoomRegistry& registry, uint16_t index) {
+        registry.endWrite(index);
+    }
+
+    // Field stores of a write in progress, as writeSamples() makes them
+    static void storeFields(RoomRegistry& registry, uint16_t index, const RoomSample_t& sample) {
+        __atomic_store_n(&registry.temperature[index], sample.temperature, __ATOMIC_RELAXED);
+        __atomic_store_n(&registry.motion[index], sample.motion, __ATOMIC_RELAXED);
+        __atomic_store_n(&registry.sampleTime[index], sample.sampleTime, __ATOMIC_RELAXED);
+    }
+};
+
+namespace {
+
+// Every field of write n is derived from n, so a mix of two writes is detectable
+RoomSample_t related_sample(uint32_t n) {
+    RoomSample_t sample;
+    sample.temperature = static_cast<uint16_t>(n);
+    sample.motion      = static_cast<uint16_t>(n * 7U + 3U);
+    sample.sampleTime  = n;
+    return sample;
+}
+
+bool is_consistent(const RoomSample_t& sample) {
+    RoomSample_t expected = related_sample(sample.sampleTime);
+    return sample.temperature == expected.temperature && sample.motion == expected.motion;
+}
+
+/**
+ * One writer publishes related values into two slots while readers copy both;
+ * every copy must be internally consistent and no slot may go back in time.
+*/
+void test_seqlock_snapshots_are_consistent() {
+    static RoomRegistry registry(ROOM_REGISTRY_EMPTY);
+    std::atomic<bool> writing(true);
+    std::atomic<uint32_t> torn(0U);
+    std::atomic<uint32_t> backwards(0U);
+    std::atomic<uint64_t> reads(0U);
+
+    RoomSample_t samples[SEQLOCK_ROOMS];
+    for (uint16_t i = 0U; i < SEQLOCK_ROOMS; i++) {
+        TEST_CHECK(registry.addRoom(static_cast<uint16_t>(201U + i)) == i);
+        samples[i] = related_sample(i);
+    }
+    registry.writeSamples(0U, SEQLOCK_ROOMS, samples);  // Readers never see the all-zero start
+
+    std::thread readers[SEQLOCK_READERS];
+    for (uint32_t r = 0U; r < SEQLOCK_READERS; r++) {
+        readers[r] = std::thread([&]() {
+            RoomSample_t copies[SEQLOCK_ROOMS];
+            uint32_t last[SEQLOCK_ROOMS] = {0U};
+            uint64_t count = 0U;
+            do {
+                registry.readSamples(0U, SEQLOCK_ROOMS, copies);
+                for (uint16_t i = 0U; i < SEQLOCK_ROOMS; i++) {
+                    if (!is_consistent(copies[i])) {
+                        torn++;
+                    }
+                    if (copies[i].sampleTime < last[i]) {
+                        backwards++;
+                    }
+                    last[i] = copies[i].sampleTime;
+                }
+                count++;
+            } while (writing.load(std::memory_order_relaxed));
+            reads += count;
+        });
+    }
+
+    for (uint32_t n = 1U; n <= SEQLOCK_WRITES; n++) {
+        for (uint16_t i = 0U; i < SEQLOCK_ROOMS; i++) {
+            samples[i] = related_sample(n * SEQLOCK_ROOMS + i);
+        }
+        registry.writeSamples(0U, SEQLOCK_ROOMS, samples);
+    }
+    writing.store(false, std::memory_order_relaxed);
+    for (uint32_t r = 0U; r < SEQLOCK_READERS; r++) {
+        readers[r].join();
+    }
+
+    printf("  %lu writes, %llu reads\n", (unsigned long)SEQLOCK_WRITES, (unsigned long long)reads.load());
+    TEST_CHECK(torn.load() == 0U);
+    TEST_CHECK(backwards.load() == 0U);
+    TEST_CHECK(reads.load() >= SEQLOCK_READERS);
+}
+
+/**
+ * A reader that starts while a write is in progress (odd sequence) must spin until
+ * endWrite() and then return the new values, not the half-written ones.
+*/
+void test_seqlock_reader_waits_for_write_in_progress() {
+    static RoomRegistry registry(ROOM_REGISTRY_EMPTY);
+    std::atomic<bool> done(false);
+    RoomSample_t seen = {0U, 0U, 0U};
+    RoomSample_t before = related_sample(10U);
+    RoomSample_t after = related_sample(20U);
+    RoomSample_t half = after;
+    uint16_t slot = registry.addRoom(301U);
+
+    TEST_CHECK(slot == 0U);
+    registry.writeSamples(slot, 1U, &before);
+
+    RoomRegistryTest::beginWrite(registry, slot);
+    half.motion = before.motion;                        // Temperature and time stored, motion not yet
+    RoomRegistryTest::storeFields(registry, slot, half);
+
+    std::thread reader([&]() {
+        registry.readSamples(slot, 1U, &seen);
+        done.store(true);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    TEST_CHECK(!done.load());                           // Still retrying on the odd sequence
+
+    RoomRegistryTest::storeFields(registry, slot, after);
+    RoomRegistryTest::endWrite(registry, slot);
+    reader.join();
+
+    TEST_CHECK(done.load());
+    TEST_CHECK(seen.temperature == after.temperature);
+    TEST_CHECK(seen.motion == after.motion);
+    TEST_CHECK(seen.sampleTime == after.sampleTime);
+}
+
+/**
+ * writeSamples() and each single-field setter record one sample; the window is the
+ * newest samples, oldest first, clamped to maxSamples and to ROOM_HISTORY_DEPTH.
+*/
+void test_history_records_every_write() {
+    static RoomRegistry registry(ROOM_REGISTRY_EMPTY);
+    RoomSample_t window[ROOM_HISTORY_DEPTH + 1U];
+    uint32_t recorded = 123U;
+    uint16_t slot = registry.addRoom(501U);
+
+    TEST_CHECK(registry.readHistory(slot, ROOM_HISTORY_DEPTH, window, &recorded) == 0U);
+    TEST_CHECK(recorded == 0U);
+    TEST_CHECK(registry.readHistory(static_cast<uint16_t>(slot + 1U), ROOM_HISTORY_DEPTH, window, nullptr) == 0U);
+
+    RoomSample_t first = related_sample(1U);
+    registry.writeSamples(slot, 1U, &first);
+    registry.setTemperature(slot, 40U);
+    registry.setMotion(slot, 41U);
+    registry.setSampleTime(slot, 42U);
+
+    TEST_CHECK(registry.readHistory(slot, ROOM_HISTORY_DEPTH, window, &recorded) == 4U);
+    TEST_CHECK(recorded == 4U);
+    TEST_CHECK(window[0].temperature == first.temperature && window[0].motion == first.motion &&
+               window[0].sampleTime == first.sampleTime);
+    TEST_CHECK(window[1].temperature == 40U && window[1].motion == first.motion && window[1].sampleTime == 1U);
+    TEST_CHECK(window[2].temperature == 40U && window[2].motion == 41U && window[2].sampleTime == 1U);
+    TEST_CHECK(window[3].temperature == 40U && window[3].motion == 41U && window[3].sampleTime == 42U);
+
+    // Past the ring size only the newest ROOM_HISTORY_DEPTH remain
+    for (uint32_t n = 100U; n < 100U + 2U * ROOM_HISTORY_DEPTH + 3U; n++) {
+        RoomSample_t sample = related_sample(n);
+        registry.writeSamples(slot, 1U, &sample);
+    }
+    uint32_t last = 100U + 2U * ROOM_HISTORY_DEPTH + 2U;
+    TEST_CHECK(registry.readHistory(slot, ROOM_HISTORY_DEPTH + 1U, window, &recorded) == ROOM_HISTORY_DEPTH);
+    TEST_CHECK(recorded == 4U + 2U * ROOM_HISTORY_DEPTH + 3U);
+    for (uint16_t i = 0U; i < ROOM_HISTORY_DEPTH; i++) {
+        TEST_CHECK(window[i].sampleTime == last - ROOM_HISTORY_DEPTH + 1U + i);
+        TEST_CHECK(is_consistent(window[i]));
+    }
+
+    TEST_CHECK(registry.readHistory(slot, 3U, window, nullptr) == 3U);
+    TEST_CHECK(window[0].sampleTime == last - 2U && window[2].sampleTime == last);
+}
+
+/**
+ * readBlock() returns the selected sensor's samples recorded after `since`, the
+ * newest SAMPLE_BLOCK_LEN at most, and the count to pass as `since` next time.
+*/
+void test_history_block_takes_new_samples() {
+    static RoomRegistry registry;                       // Topology rooms, for the sensor IDs
+    static RoomRegistry empty(ROOM_REGISTRY_EMPTY);
+    SampleBlock_t block;
+    uint16_t slot = 0U;
+
+    TEST_CHECK(reinterpret_cast<uintptr_t>(&block) % SAMPLE_BLOCK_ALIGN == 0U);
+    TEST_CHECK(reinterpret_cast<uintptr_t>(block.timestamps) % SAMPLE_BLOCK_ALIGN == 0U);
+    TEST_CHECK(registry.readBlock(slot, SENSOR_TEMPERATURE, 0U, &block) == 0U);
+    TEST_CHECK(block.count == 0U && block.recorded == 0U);
+    TEST_CHECK(block.sensorId == registry.getTopology(slot)->temperatureSensorId);
+
+    for (uint32_t n = 1U; n <= 3U; n++) {
+        RoomSample_t sample = related_sample(n);
+        registry.writeSamples(slot, 1U, &sample);
+    }
+    TEST_CHECK(registry.readBlock(slot, SENSOR_MOTION, 0U, &block) == 3U);
+    TEST_CHECK(block.sensorId == registry.getTopology(slot)->motionSensorId);
+    TEST_CHECK(block.recorded == 3U);
+    for (uint16_t i = 0U; i < 3U; i++) {
+        TEST_CHECK(block.values[i] == related_sample(i + 1U).motion && block.timestamps[i] == i + 1U);
+    }
+
+    // Only what was recorded since the last block, then nothing
+    uint32_t since = block.recorded;
+    RoomSample_t fourth = related_sample(4U);
+    registry.writeSamples(slot, 1U, &fourth);
+    TEST_CHECK(registry.readBlock(slot, SENSOR_TEMPERATURE, since, &block) == 1U);
+    TEST_CHECK(block.values[0] == fourth.temperature && block.timestamps[0] == 4U);
+    TEST_CHECK(registry.readBlock(slot, SENSOR_TEMPERATURE, block.recorded, &block) == 0U);
+
+    // A backlog larger than the block or the ring keeps its newest samples
+    for (uint32_t n = 5U; n < 5U + ROOM_HISTORY_DEPTH + SAMPLE_BLOCK_LEN; n++) {
+        RoomSample_t sample = related_sample(n);
+        registry.writeSamples(slot, 1U, &sample);
+    }
+    uint32_t last = 4U + ROOM_HISTORY_DEPTH + SAMPLE_BLOCK_LEN;
+    uint16_t expected = (ROOM_HISTORY_DEPTH < SAMPLE_BLOCK_LEN) ? ROOM_HISTORY_DEPTH : SAMPLE_BLOCK_LEN;
+    TEST_CHECK(registry.readBlock(slot, SENSOR_TEMPERATURE, 4U, &block) == expected);
+    TEST_CHECK(block.recorded == last);
+    TEST_CHECK(block.timestamps[0] == last - expected + 1U && block.timestamps[expected - 1U] == last);
+
+    // Rooms added at runtime have no sensor IDs; slots out of range give nothing
+    uint16_t added = empty.addRoom(701U);
+    RoomSample_t sample = related_sample(9U);
+    empty.writeSamples(added, 1U, &sample);
+    TEST_CHECK(empty.readBlock(added, SENSOR_TEMPERATURE, 0U, &block) == 1U && block.sensorId == 0U);
+    TEST_CHECK(empty.readBlock(static_cast<uint16_t>(added + 1U), SENSOR_TEMPERATURE, 0U, &block) == 0U);
+}
+
+/**
+ * Readers copying whole windows while one writer records must see consecutive
+ * samples of completed writes, ending at the sample count they were given.
+*/
+void test_history_windows_are_consistent() {
+    static RoomRegistry registry(ROOM_REGISTRY_EMPTY);
+    std::atomic<bool> writing(true);
+    std::atomic<uint32_t> broken(0U);
+    std::atomic<uint64_t> reads(0U);
+    uint16_t slot = registry.addRoom(601U);
+
+    TEST_CHECK(slot == 0U);
+    std::thread readers[SEQLOCK_READERS];
+    for (uint32_t r = 0U; r < SEQLOCK_READERS; r++) {
+        readers[r] = std::thread([&]() {
+            RoomSample_t window[ROOM_HISTORY_DEPTH];
+            uint32_t recorded = 0U;
+            uint64_t count = 0U;
+            do {
+                uint16_t n = registry.readHistory(slot, ROOM_HISTORY_DEPTH, window, &recorded);
+                for (uint16_t i = 0U; i < n; i++) {
+                    // Sample n was the n-th recorded, so the window ends at the count
+                    if (!is_consistent(window[i]) || window[i].sampleTime != recorded - n + 1U + i) {
+                        broken++;
+                    }
+                }
+                count++;
+            } while (writing.load(std::memory_order_relaxed));
+            reads += count;
+        });
+    }
+
+    for (uint32_t n = 1U; n <= HISTORY_WRITES; n++) {
+        RoomSample_t sample = related_sample(n);
+        registry.writeSamples(slot, 1U, &sample);
+    }
+    writing.store(false, std::memory_order_relaxed);
+    for (uint32_t r = 0U; r < SEQLOCK_READERS; r++) {
+        readers[r].join();
+    }
+
+    printf("  %lu writes, %llu window reads\n", (unsigned long)HISTORY_WRITES, (unsigned long long)reads.load());
+    TEST_CHECK(broken.load() == 0U);
+    TEST_CHECK(reads.load() >= SEQLOCK_READERS);
+}
+
+void add_device_rooms(RoomRegistry& registry) {
+    for (uint16_t i = 0U; i < DEVICE_ROOMS; i++) {
+        TEST_CHECK(registry.addRoom(static_cast<uint16_t>(401U + i)) == i);
+    }
+}
+
+/**
+ * Take every pending change in chunks of maxChanges, counting each chunk in
+ * chunks[] (up to maxChunks). Each (kind, room) must be reported at most once and
+ * with its current state; seen[kind][room] is set for every reported device.
+ * @return Total number of changes taken.
+*/
+uint32_t take_all(RoomRegistry& registry, uint16_t maxChanges, uint16_t* chunks, uint32_t maxChunks,
+                  bool (*seen)[DEVICE_ROOMS]) {
+    DeviceChange_t changes[DEVICE_KIND_COUNT * DEVICE_ROOMS];
+    uint32_t total = 0U;
+    uint32_t calls = 0U;
+    uint16_t taken;
+
+    do {
+        taken = registry.takeDeviceChanges(changes, maxChanges);
+        TEST_CHECK(taken <= maxChanges);
+        if (calls < maxChunks) {
+            chunks[calls] = taken;
+        }
+        calls++;
+        for (uint16_t i = 0U; i < taken; i++) {
+            const DeviceChange_t& change = changes[i];
+            TEST_CHECK(change.kind < DEVICE_KIND_COUNT);
+            TEST_CHECK(change.roomIndex < DEVICE_ROOMS);
+            if (change.kind >= DEVICE_KIND_COUNT || change.roomIndex >= DEVICE_ROOMS) {
+                continue;
+            }
+            TEST_CHECK(!seen[change.kind][change.roomIndex]);
+            seen[change.kind][change.roomIndex] = true;
+            TEST_CHECK((change.on != 0U) == registry.getDevice(static_cast<DeviceKind_t>(change.kind), change.roomIndex));
+        }
+        total += taken;
+    } while (taken > 0U);
+
+    return total;
+}
+
+/**
+ * 40 lights switched on, taken 16 at a time: 16 + 16 from word 0 (the second half
+ * put back by the first call), then the 8 rooms of the partial word 1.
+*/
+void test_take_device_changes_in_chunks() {
+    static RoomRegistry registry(ROOM_REGISTRY_EMPTY);
+    bool seen[DEVICE_KIND_COUNT][DEVICE_ROOMS] = {};
+    uint16_t chunks[4] = {0U};
+
+    add_device_rooms(registry);
+    for (uint16_t i = 0U; i < DEVICE_ROOMS; i++) {
+        registry.setLight(i, true);
+    }
+    registry.setLight(0U, true);                        // No change, no extra report
+
+    TEST_CHECK(take_all(registry, DEVICE_CHUNK, chunks, 4U, seen) == DEVICE_ROOMS);
+    TEST_CHECK(chunks[0] == 16U);
+    TEST_CHECK(chunks[1] == 16U);
+    TEST_CHECK(chunks[2] == 8U);
+    TEST_CHECK(chunks[3] == 0U);
+    for (uint16_t i = 0U; i < DEVICE_ROOMS; i++) {
+        TEST_CHECK(seen[DEVICE_LIGHT][i]);
+        TEST_CHECK(!seen[DEVICE_AC][i] && !seen[DEVICE_HEATER][i]);
+    }
+
+    // A light switched back off is reported again, with its new state
+    registry.setLight(35U, false);
+    DeviceChange_t change;
+    TEST_CHECK(registry.takeDeviceChanges(&change, 1U) == 1U);
+    TEST_CHECK(change.roomIndex == 35U && change.kind == DEVICE_LIGHT && change.on == 0U);
+    TEST_CHECK(registry.takeDeviceChanges(&change, 1U) == 0U);
+}
+
+/** markAllDevicesDirty() reports every device of the 40 rooms once, none past the last room */
+void test_mark_all_devices_dirty() {
+    static RoomRegistry registry(ROOM_REGISTRY_EMPTY);
+    bool seen[DEVICE_KIND_COUNT][DEVICE_ROOMS] = {};
+    uint16_t chunks[8] = {0U};
+
+    add_device_rooms(registry);
+    registry.setHeater(39U, true);
+    (void)take_all(registry, DEVICE_CHUNK, chunks, 8U, seen);
+
+    registry.markAllDevicesDirty();
+    for (uint32_t kind = 0U; kind < DEVICE_KIND_COUNT; kind++) {
+        for (uint16_t i = 0U; i < DEVICE_ROOMS; i++) {
+            seen[kind][i] = false;
+        }
+    }
+    TEST_CHECK(take_all(registry, DEVICE_CHUNK, chunks, 8U, seen) == DEVICE_KIND_COUNT * DEVICE_ROOMS);
+    for (uint32_t kind = 0U; kind < DEVICE_KIND_COUNT; kind++) {
+        for (uint16_t i = 0U; i < DEVICE_ROOMS; i++) {
+            TEST_CHECK(seen[kind][i]);
+        }
+    }
+}
+
+/**
+ * controlAll() from all devices off: every room has motion, half are above the AC
+ * threshold and half below the heater threshold, so 40 + 20 + 20 = 80 changes.
+ * A second pass with the same readings changes nothing.
+*/
+void test_control_all() {
+    static RoomRegistry registry(ROOM_REGISTRY_EMPTY);
+    bool seen[DEVICE_KIND_COUNT][DEVICE_ROOMS] = {};
+    uint16_t chunks[8] = {0U};
+    RoomSample_t sample;
+
+    add_device_rooms(registry);
+    for (uint16_t i = 0U; i < DEVICE_ROOMS; i++) {
+        sample.temperature = (i % 2U == 0U) ? (AC_ABOVE + 5U) : (HEATER_BELOW - 5U);
+        sample.motion      = 1U;
+        sample.sampleTime  = i;
+        registry.writeSamples(i, 1U, &sample);
+    }
+
+    registry.controlAll(AC_ABOVE, HEATER_BELOW);
+    TEST_CHECK(take_all(registry, DEVICE_CHUNK, chunks, 8U, seen) == 80U);
+    for (uint16_t i = 0U; i < DEVICE_ROOMS; i++) {
+        bool hot = (i % 2U == 0U);
+        TEST_CHECK(seen[DEVICE_LIGHT][i] && registry.getLight(i));
+        TEST_CHECK(seen[DEVICE_AC][i] == hot && registry.getAC(i) == hot);
+        TEST_CHECK(seen[DEVICE_HEATER][i] == !hot && registry.getHeater(i) == !hot);
+    }
+
+    registry.controlAll(AC_ABOVE, HEATER_BELOW);
+    DeviceChange_t change;
+    TEST_CHECK(registry.takeDeviceChanges(&change, 1U) == 0U);
+}
+
+} // namespace
+
+int main() {
+    TEST_RUN(test_seqlock_snapshots_are_consistent);
+    TEST_RUN(test_seqlock_reader_waits_for_write_in_progress);
+    TEST_RUN(test_history_records_every_write);
+    TEST_RUN(test_history_block_takes_new_samples);
+    TEST_RUN(test_history_windows_are_consistent);
+    TEST_RUN(test_take_device_changes_in_chunks);
+    TEST_RUN(test_mark_all_devices_dirty);
+    TEST_RUN(test_control_all);
+    return test_finish("test_room_registry");
+}